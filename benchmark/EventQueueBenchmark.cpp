@@ -0,0 +1,113 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+/**
+ * Microbenchmark of the EventQueue scheduler policies, using the classic "hold" model:
+ * a fixed number of events is kept pending, and every invoked event schedules
+ * a new event at (current time + random increment).
+ */
+namespace {
+
+/// state shared by the events of a hold model run
+struct HoldModel {
+    /// event queue under test
+    EventQueue* event_queue;
+
+    /// random number generator for time increments
+    std::mt19937_64 rng;
+
+    /// maximum time increment in ns
+    EventTime max_increment;
+
+    /// number of invoked events
+    uint64_t invoked_count;
+};
+
+/// invoked event: reschedule itself in the future
+void hold_event(void* const arg) {
+    auto* const model = static_cast<HoldModel*>(arg);
+    model->invoked_count++;
+
+    const auto increment = model->rng() % model->max_increment;
+    const auto event_time = model->event_queue->get_current_time() + increment;
+    model->event_queue->schedule_event(event_time, hold_event, arg);
+}
+
+/// run the hold model and return the throughput in events/sec
+double run_hold_model(const EventSchedulerPolicy policy,
+                      const int pending_events_count,
+                      const EventTime max_increment,
+                      const uint64_t events_count) {
+    auto event_queue = EventQueue(policy);
+    auto model = HoldModel{&event_queue, std::mt19937_64(0), max_increment, 0};
+
+    // fill the queue with pending events
+    for (auto i = 0; i < pending_events_count; i++) {
+        event_queue.schedule_event(model.rng() % max_increment, hold_event, &model);
+    }
+
+    // run until enough events are invoked or the time budget is spent
+    const auto time_budget = std::chrono::seconds(2);
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+    while (model.invoked_count < events_count) {
+        event_queue.proceed();
+
+        if ((model.invoked_count & 0x3FF) == 0) {
+            elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed > time_budget) {
+                break;
+            }
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return static_cast<double>(model.invoked_count) / seconds;
+}
+
+}  // namespace
+
+int main() {
+    const auto policies = std::vector<std::pair<EventSchedulerPolicy, std::string>>{
+        {EventSchedulerPolicy::List, "List"},
+        {EventSchedulerPolicy::BinaryHeap, "BinaryHeap"},
+        {EventSchedulerPolicy::RadixHeap, "RadixHeap"},
+        {EventSchedulerPolicy::Calendar, "Calendar"},
+    };
+    const auto pending_events_counts = std::vector<int>{8, 64, 512, 4'096, 32'768};
+    const auto max_increments = std::vector<EventTime>{64, 100'000};
+    const auto events_count = uint64_t{2'000'000};
+
+    // print header
+    std::cout << std::left << std::setw(12) << "policy" << std::setw(10) << "pending" << std::setw(14)
+              << "max_incr(ns)" << "events/sec" << std::endl;
+
+    // run benchmarks
+    for (const auto max_increment : max_increments) {
+        for (const auto pending_events_count : pending_events_counts) {
+            for (const auto& [policy, policy_name] : policies) {
+                const auto throughput = run_hold_model(policy, pending_events_count, max_increment, events_count);
+                std::cout << std::left << std::setw(12) << policy_name << std::setw(10) << pending_events_count
+                          << std::setw(14) << max_increment << std::fixed << std::setprecision(0) << throughput
+                          << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Switch.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/Switch.h"
+#include "reconfigurable/Chunk.h"
+#include "reconfigurable/SimulationContext.h"
+#include "reconfigurable/TopologyManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace Aware = NetworkAnalyticalCongestionAware;
+namespace Unaware = NetworkAnalyticalCongestionUnaware;
+namespace Reconfigurable = NetworkAnalyticalReconfigurable;
+
+/**
+ * Throughput benchmark of the simulator backends.
+ *
+ * Every NPU of a Ring, Switch or FullyConnected topology sends a chunk to each of its
+ * next peers_per_npu NPUs, and the run reports construction time, simulation throughput
+ * in chunks and events per second, the cost of EventQueue::schedule_event at the size and time span
+ * of the run, and the peak RSS. Each configuration runs in its own child process,
+ * so its peak RSS isn't inflated by the configurations run before it.
+ * Results are written as JSON, to be compared across versions.
+ */
+namespace {
+
+/// bandwidth of every link in GB/s
+constexpr Bandwidth bandwidth = 50;
+
+/// latency of every link in ns
+constexpr Latency latency = 500;
+
+/// size of every chunk
+constexpr ChunkSize chunk_size = 1'048'576;
+
+/// number of chunks each NPU sends, to its next NPUs
+constexpr int peers_per_npu = 8;
+
+/// largest number of NPUs the reconfigurable backend runs at,
+/// as it configures circuits through dense devices_count x devices_count matrices
+constexpr int reconfigurable_max_npus = 1'024;
+
+/// largest number of events scheduled to measure schedule_event
+constexpr uint64_t schedule_events_max_count = 1 << 20;
+
+/// clock measuring wall time
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Configuration of a benchmark run.
+ */
+struct BenchmarkConfig {
+    /// simulator backend
+    std::string backend;
+
+    /// topology name
+    std::string topology;
+
+    /// number of NPUs
+    int npus_count;
+};
+
+/**
+ * Measurements of a benchmark run.
+ */
+struct BenchmarkResult {
+    /// wall time to construct the topology, in ms
+    double construction_ms = 0;
+
+    /// wall time to simulate the chunks, in ms
+    double simulation_ms = 0;
+
+    /// number of chunks sent
+    uint64_t chunks_count = 0;
+
+    /// number of events scheduled while simulating, 0 for backends without events
+    uint64_t events_count = 0;
+
+    /// time the last chunk arrives, in ns
+    EventTime simulated_time = 0;
+
+    /// wall time per EventQueue::schedule_event, in ns, 0 for backends without events
+    double schedule_event_ns = 0;
+};
+
+/// get the wall time elapsed since the given time, in ms
+double elapsed_ms(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// get the peers each NPU sends a chunk to
+std::vector<std::pair<int, int>> build_traffic(const int npus_count) {
+    const auto peers_count = std::min(peers_per_npu, npus_count - 1);
+
+    auto traffic = std::vector<std::pair<int, int>>();
+    traffic.reserve(static_cast<size_t>(npus_count) * peers_count);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto offset = 1; offset <= peers_count; offset++) {
+            traffic.emplace_back(src, (src + offset) % npus_count);
+        }
+    }
+    return traffic;
+}
+
+/// event doing nothing
+void noop_event(void* const) {}
+
+/// measure the cost of scheduling the given number of events over the given time span
+double measure_schedule_event(const uint64_t events_count, const EventTime time_span) {
+    const auto count = std::max<uint64_t>(1, std::min(events_count, schedule_events_max_count));
+    auto rng = std::mt19937_64(0);
+    auto event_times = std::vector<EventTime>(count);
+    for (auto& event_time : event_times) {
+        event_time = rng() % (time_span + 1);
+    }
+
+    auto event_queue = EventQueue();
+    const auto start = Clock::now();
+    for (const auto event_time : event_times) {
+        event_queue.schedule_event(event_time, noop_event, nullptr);
+    }
+    return elapsed_ms(start) * 1e6 / static_cast<double>(count);
+}
+
+/// run the congestion_aware backend
+BenchmarkResult run_congestion_aware(const BenchmarkConfig& config) {
+    auto result = BenchmarkResult();
+    const auto event_queue = std::make_shared<EventQueue>();
+    const auto context = std::make_shared<Aware::SimulationContext>(event_queue);
+
+    // construct the topology
+    auto start = Clock::now();
+    auto topology = std::shared_ptr<Aware::Topology>();
+    if (config.topology == "Ring") {
+        topology = std::make_shared<Aware::Ring>(config.npus_count, bandwidth, latency);
+    } else if (config.topology == "Switch") {
+        topology = std::make_shared<Aware::Switch>(config.npus_count, bandwidth, latency);
+    } else {
+        topology = std::make_shared<Aware::FullyConnected>(config.npus_count, bandwidth, latency);
+    }
+    topology->set_context(context);
+    result.construction_ms = elapsed_ms(start);
+
+    // simulate
+    start = Clock::now();
+    for (const auto& [src, dest] : build_traffic(config.npus_count)) {
+        topology->send(std::make_unique<Aware::Chunk>(chunk_size, topology->cached_route(src, dest), noop_event,
+                                                      nullptr));
+        result.chunks_count++;
+    }
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    result.simulation_ms = elapsed_ms(start);
+    result.events_count = event_queue->get_scheduled_events_count();
+    result.simulated_time = event_queue->get_current_time();
+    result.schedule_event_ns = measure_schedule_event(result.events_count, result.simulated_time);
+
+    return result;
+}
+
+/// run the congestion_unaware backend, where each chunk is a closed-form delay
+BenchmarkResult run_congestion_unaware(const BenchmarkConfig& config) {
+    auto result = BenchmarkResult();
+
+    // construct the topology
+    auto start = Clock::now();
+    auto topology = std::shared_ptr<Unaware::Topology>();
+    if (config.topology == "Ring") {
+        topology = std::make_shared<Unaware::Ring>(config.npus_count, bandwidth, latency);
+    } else if (config.topology == "Switch") {
+        topology = std::make_shared<Unaware::Switch>(config.npus_count, bandwidth, latency);
+    } else {
+        topology = std::make_shared<Unaware::FullyConnected>(config.npus_count, bandwidth, latency);
+    }
+    result.construction_ms = elapsed_ms(start);
+
+    // lay out the traffic as a batch
+    auto srcs = std::vector<DeviceId>();
+    auto dests = std::vector<DeviceId>();
+    for (const auto& [src, dest] : build_traffic(config.npus_count)) {
+        srcs.push_back(src);
+        dests.push_back(dest);
+    }
+    const auto chunk_sizes = std::vector<ChunkSize>(srcs.size(), chunk_size);
+    auto delays = std::vector<EventTime>();
+
+    // simulate
+    start = Clock::now();
+    topology->send_batch(srcs, dests, chunk_sizes, delays);
+    result.simulated_time = *std::max_element(delays.begin(), delays.end());
+    result.chunks_count = delays.size();
+    result.simulation_ms = elapsed_ms(start);
+
+    return result;
+}
+
+/// run the reconfigurable backend, with circuits matching the topology
+BenchmarkResult run_reconfigurable(const BenchmarkConfig& config) {
+    auto result = BenchmarkResult();
+    const auto event_queue = std::make_shared<EventQueue>();
+    const auto context = std::make_shared<Reconfigurable::SimulationContext>(event_queue);
+    const auto npus_count = config.npus_count;
+
+    // construct the topology and configure its circuits, switch included
+    auto start = Clock::now();
+    const auto devices_count = (config.topology == "Switch") ? npus_count + 1 : npus_count;
+    auto topology_manager = Reconfigurable::TopologyManager(npus_count, devices_count, context);
+    auto bandwidths = std::vector<std::vector<Bandwidth>>(devices_count, std::vector<Bandwidth>(devices_count, 0));
+    auto latencies = std::vector<std::vector<Latency>>(devices_count, std::vector<Latency>(devices_count, 0));
+    const auto connect = [&](const int src, const int dest) {
+        bandwidths[src][dest] = bandwidths[dest][src] = bandwidth;
+        latencies[src][dest] = latencies[dest][src] = latency;
+    };
+    for (auto i = 0; i < npus_count; i++) {
+        if (config.topology == "Ring") {
+            connect(i, (i + 1) % npus_count);
+        } else if (config.topology == "Switch") {
+            connect(i, npus_count);
+        } else {
+            for (auto j = i + 1; j < npus_count; j++) {
+                connect(i, j);
+            }
+        }
+    }
+    topology_manager.reconfigure(std::move(bandwidths), std::move(latencies), 0);
+    result.construction_ms = elapsed_ms(start);
+    const auto construction_events_count = event_queue->get_scheduled_events_count();
+
+    // simulate
+    start = Clock::now();
+    for (const auto& [src, dest] : build_traffic(npus_count)) {
+        topology_manager.send(std::make_unique<Reconfigurable::Chunk>(chunk_size, topology_manager.route(src, dest),
+                                                                      noop_event, nullptr, -1));
+        result.chunks_count++;
+    }
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    result.simulation_ms = elapsed_ms(start);
+    result.events_count = event_queue->get_scheduled_events_count() - construction_events_count;
+    result.simulated_time = event_queue->get_current_time();
+    result.schedule_event_ns = measure_schedule_event(result.events_count, result.simulated_time);
+
+    return result;
+}
+
+/// write the measurements of a run as the fields of a JSON object
+std::string result_to_json(const BenchmarkResult& result) {
+    const auto per_sec = [](const uint64_t count, const double ms) {
+        return (ms > 0) ? static_cast<double>(count) * 1e3 / ms : 0.0;
+    };
+
+    auto json = std::ostringstream();
+    json << "\"construction_ms\": " << result.construction_ms << ", \"simulation_ms\": " << result.simulation_ms
+         << ", \"chunks_count\": " << result.chunks_count << ", \"events_count\": " << result.events_count
+         << ", \"chunks_per_sec\": " << per_sec(result.chunks_count, result.simulation_ms)
+         << ", \"events_per_sec\": " << per_sec(result.events_count, result.simulation_ms)
+         << ", \"schedule_event_ns\": " << result.schedule_event_ns
+         << ", \"simulated_time_ns\": " << result.simulated_time;
+    return json.str();
+}
+
+/// run a configuration in a child process, returning its JSON object
+std::string run_isolated(const BenchmarkConfig& config) {
+    auto json = std::ostringstream();
+    json << "{\"backend\": \"" << config.backend << "\", \"topology\": \"" << config.topology
+         << "\", \"npus_count\": " << config.npus_count;
+
+    if (config.backend == "reconfigurable" && config.npus_count > reconfigurable_max_npus) {
+        json << ", \"skipped\": \"dense circuit configuration beyond " << reconfigurable_max_npus << " NPUs\"}";
+        return json.str();
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::cerr << "[Error] (network/analytical/benchmark) " << "cannot create pipe" << std::endl;
+        std::exit(-1);
+    }
+
+    const auto pid = fork();
+    if (pid == 0) {
+        // child: run the configuration and report its measurements
+        close(fds[0]);
+        auto result = BenchmarkResult();
+        if (config.backend == "congestion_aware") {
+            result = run_congestion_aware(config);
+        } else if (config.backend == "congestion_unaware") {
+            result = run_congestion_unaware(config);
+        } else {
+            result = run_reconfigurable(config);
+        }
+        const auto fields = result_to_json(result);
+        const auto written = write(fds[1], fields.data(), fields.size());
+        close(fds[1]);
+        _exit(written == static_cast<ssize_t>(fields.size()) ? 0 : 1);
+    }
+
+    // parent: collect the measurements and the peak RSS of the child
+    close(fds[1]);
+    auto fields = std::string();
+    char buffer[4096];
+    for (auto count = read(fds[0], buffer, sizeof(buffer)); count > 0; count = read(fds[0], buffer, sizeof(buffer))) {
+        fields.append(buffer, count);
+    }
+    close(fds[0]);
+
+    auto status = 0;
+    auto usage = rusage{};
+    wait4(pid, &status, 0, &usage);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || fields.empty()) {
+        json << ", \"failed\": true}";
+        return json.str();
+    }
+
+    // ru_maxrss is in KB on Linux
+    json << ", " << fields << ", \"peak_rss_kb\": " << usage.ru_maxrss << "}";
+    return json.str();
+}
+
+}  // namespace
+
+/**
+ * Usage: Analytical_Benchmarks [--output <file>] [--max-npus <n>] [--backend <name>] [--topology <name>]
+ */
+int main(const int argc, const char* const argv[]) {
+    auto output_path = std::string();
+    auto max_npus = 8'192;
+    auto backends = std::vector<std::string>{"congestion_unaware", "congestion_aware", "reconfigurable"};
+    auto topologies = std::vector<std::string>{"Ring", "Switch", "FullyConnected"};
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto arg = std::string(argv[i]);
+        if (i + 1 == argc) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--output <file>] [--max-npus <n>] [--backend <name>] [--topology <name>]" << std::endl;
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+        if (arg == "--output") {
+            output_path = value;
+        } else if (arg == "--max-npus") {
+            max_npus = std::stoi(value);
+        } else if (arg == "--backend") {
+            backends = {value};
+        } else if (arg == "--topology") {
+            topologies = {value};
+        } else {
+            std::cerr << "[Error] (network/analytical/benchmark) " << "unknown argument " << arg << std::endl;
+            return -1;
+        }
+    }
+
+    // run every configuration
+    auto results = std::vector<std::string>();
+    for (const auto& backend : backends) {
+        for (const auto& topology : topologies) {
+            for (const auto npus_count : {8, 64, 512, 4'096, 8'192}) {
+                if (npus_count > max_npus) {
+                    continue;
+                }
+                std::cerr << "running " << backend << " " << topology << " " << npus_count << std::endl;
+                results.push_back(run_isolated({backend, topology, npus_count}));
+            }
+        }
+    }
+
+    // write results
+    auto json = std::ostringstream();
+    json << "{\"chunk_size\": " << chunk_size << ", \"peers_per_npu\": " << peers_per_npu
+         << ", \"bandwidth_GBps\": " << bandwidth << ", \"latency_ns\": " << latency << ", \"results\": [";
+    for (auto i = size_t{0}; i < results.size(); i++) {
+        json << (i == 0 ? "\n  " : ",\n  ") << results[i];
+    }
+    json << "\n]}\n";
+
+    if (output_path.empty()) {
+        std::cout << json.str();
+        return 0;
+    }
+    auto output_file = std::ofstream(output_path);
+    if (!output_file) {
+        std::cerr << "[Error] (network/analytical/benchmark) " << "cannot open " << output_path << std::endl;
+        return -1;
+    }
+    output_file << json.str();
+    return 0;
+}
@@ -4,9 +4,8 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/NetworkFunction.h"
-#include "common/Flags.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
 
 using namespace NetworkAnalytical;
 
@@ -18,9 +17,48 @@ Bandwidth NetworkAnalytical::bw_GBps_to_Bpns(const Bandwidth bw_GBps) noexcept {
     return bw_GBps * (1 << 30) / (1'000'000'000);  // GB/s to B/ns
 }
 
+ChunkSize NetworkAnalytical::part_size(const ChunkSize size, const uint64_t parts_count) noexcept {
+    assert(parts_count > 0);
 
-void NetworkAnalytical::debug_log(const std::string& msg) noexcept {
-    if constexpr (DEBUG_PRINT) {
-        std::cout << msg << std::endl;
+    return std::max(size / parts_count, ChunkSize{1});
+}
+
+std::vector<HierarchicalPhase> NetworkAnalytical::hierarchical_phases(const CollectiveType type,
+                                                                      const std::vector<int>& npus_count_per_dim,
+                                                                      const ChunkSize size) noexcept {
+    assert(size > 0);
+
+    const auto dims_count = static_cast<int>(npus_count_per_dim.size());
+    auto phases = std::vector<HierarchicalPhase>();
+
+    if (type == CollectiveType::AllToAll) {
+        for (auto dim = 0; dim < dims_count; dim++) {
+            phases.push_back({CollectiveType::AllToAll, CollectiveAlgorithm::Direct, dim, size});
+        }
+        return phases;
+    }
+
+    // reduce-scatter shrinks the buffer from the first dimension up, all-gather grows it back
+    const auto reduce_scatter = type == CollectiveType::ReduceScatter || type == CollectiveType::AllReduce;
+    const auto all_gather = type == CollectiveType::AllGather || type == CollectiveType::AllReduce;
+    auto data_size = size;
+    if (reduce_scatter) {
+        for (auto dim = 0; dim < dims_count; dim++) {
+            phases.push_back({CollectiveType::ReduceScatter, CollectiveAlgorithm::Ring, dim, data_size});
+            data_size = part_size(data_size, npus_count_per_dim[dim]);
+        }
+    } else {
+        auto npus_count = uint64_t{1};
+        for (const auto dim_size : npus_count_per_dim) {
+            npus_count *= dim_size;
+        }
+        data_size = part_size(size, npus_count);
+    }
+    if (all_gather) {
+        for (auto dim = dims_count - 1; dim >= 0; dim--) {
+            data_size *= npus_count_per_dim[dim];
+            phases.push_back({CollectiveType::AllGather, CollectiveAlgorithm::Ring, dim, data_size});
+        }
     }
+    return phases;
 }
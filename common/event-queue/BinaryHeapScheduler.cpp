@@ -0,0 +1,53 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/BinaryHeapScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+BinaryHeapScheduler::BinaryHeapScheduler() noexcept : next_sequence(0) {
+    // create empty heap
+    heap = std::vector<HeapEntry>();
+}
+
+bool BinaryHeapScheduler::empty() const noexcept {
+    return heap.empty();
+}
+
+EventTime BinaryHeapScheduler::front_time() const noexcept {
+    assert(!empty());
+
+    // the earliest entry sits on top of the heap
+    return heap.front().event_time;
+}
+
+void BinaryHeapScheduler::schedule(const EventTime event_time,
+                                   const Callback callback,
+                                   const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // push the event into the heap
+    heap.push_back({event_time, next_sequence, Event(callback, callback_arg)});
+    std::push_heap(heap.begin(), heap.end());
+    next_sequence++;
+}
+
+EventList BinaryHeapScheduler::pop() noexcept {
+    assert(!empty());
+
+    // pop every event sharing the earliest event time, in scheduling order
+    const auto event_time = heap.front().event_time;
+    auto event_list = EventList(event_time, &event_node_pool);
+    while (!heap.empty() && heap.front().event_time == event_time) {
+        std::pop_heap(heap.begin(), heap.end());
+        const auto [callback, callback_arg] = heap.back().event.get_handler_arg();
+        event_list.add_event(callback, callback_arg);
+        heap.pop_back();
+    }
+
+    return event_list;
+}
@@ -0,0 +1,215 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CalendarScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+CalendarScheduler::CalendarScheduler() noexcept
+    : bucket_width(1),
+      current_bucket(0),
+      bucket_top(1),
+      last_time(0),
+      event_lists_count(0) {
+    // create empty buckets
+    buckets = std::vector<Bucket>(min_buckets_count, nullptr);
+    width_samples.reserve(width_samples_count);
+}
+
+bool CalendarScheduler::empty() const noexcept {
+    return event_lists_count == 0;
+}
+
+EventTime CalendarScheduler::front_time() const noexcept {
+    assert(!empty());
+
+    const auto index = find_earliest().first;
+    return buckets[index]->event_list.get_event_time();
+}
+
+void CalendarScheduler::schedule(const EventTime event_time,
+                             const Callback callback,
+                             const CallbackArg callback_arg) noexcept {
+    // events cannot be scheduled in the past
+    assert(event_time >= last_time);
+    assert(callback != nullptr);
+
+    // find the EventList to insert the event.
+    // a bucket holds only a few EventLists, so a linear search suffices
+    auto* link = &buckets[bucket_index(event_time)];
+    while (*link != nullptr && (*link)->event_list.get_event_time() < event_time) {
+        link = &(*link)->next;
+    }
+
+    if (*link == nullptr || (*link)->event_list.get_event_time() != event_time) {
+        // no EventList matching event_time: create one at the sorted position
+        *link = event_list_node_pool.allocate(EventListNode{EventList(event_time, &event_node_pool), *link});
+        event_lists_count++;
+    }
+
+    // register the event
+    (*link)->event_list.add_event(callback, callback_arg);
+
+    // grow the calendar if buckets are getting crowded
+    if (event_lists_count > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+    }
+}
+
+EventList CalendarScheduler::pop() noexcept {
+    // to pop, at least one EventList should exist
+    assert(!empty());
+
+    const auto buckets_count = buckets.size();
+    const auto [index, top] = find_earliest();
+
+    // dequeue the earliest EventList
+    auto* const node = buckets[index];
+    buckets[index] = node->next;
+    auto event_list = std::move(node->event_list);
+    event_list_node_pool.release(node);
+    event_lists_count--;
+
+    // update the current position of the calendar
+    current_bucket = index;
+    bucket_top = top;
+    last_time = event_list.get_event_time();
+
+    // shrink the calendar if buckets are getting sparse
+    if (buckets_count > min_buckets_count && event_lists_count < buckets_count / 2) {
+        resize(buckets_count / 2);
+    }
+
+    return event_list;
+}
+
+std::pair<size_t, EventTime> CalendarScheduler::find_earliest() const noexcept {
+    assert(!empty());
+
+    const auto buckets_count = buckets.size();
+    auto index = current_bucket;
+    auto top = bucket_top;
+
+    // scan a whole year starting from the current day
+    for (auto scanned = size_t{0}; scanned < buckets_count; scanned++) {
+        const auto* const bucket = buckets[index];
+        if (bucket != nullptr && bucket->event_list.get_event_time() < top) {
+            return {index, top};
+        }
+
+        // move to the next day
+        index = (index + 1) & (buckets_count - 1);
+        top += bucket_width;
+    }
+
+    // every EventList is more than a year ahead: search the earliest one directly
+    auto found = false;
+    auto earliest_time = EventTime{0};
+    for (auto i = size_t{0}; i < buckets_count; i++) {
+        const auto* const bucket = buckets[i];
+        if (bucket != nullptr && (!found || bucket->event_list.get_event_time() < earliest_time)) {
+            earliest_time = bucket->event_list.get_event_time();
+            index = i;
+            found = true;
+        }
+    }
+    assert(found);
+
+    return {index, (earliest_time / bucket_width + 1) * bucket_width};
+}
+
+size_t CalendarScheduler::bucket_index(const EventTime event_time) const noexcept {
+    // bucket count is a power of 2
+    return static_cast<size_t>(event_time / bucket_width) & (buckets.size() - 1);
+}
+
+void CalendarScheduler::insert_sorted(EventListNode* const node) noexcept {
+    const auto event_time = node->event_list.get_event_time();
+
+    // find the sorted position
+    auto* link = &buckets[bucket_index(event_time)];
+    while (*link != nullptr && (*link)->event_list.get_event_time() < event_time) {
+        link = &(*link)->next;
+    }
+
+    // relink the node without reallocation
+    node->next = *link;
+    *link = node;
+}
+
+EventTime CalendarScheduler::estimate_bucket_width() noexcept {
+    // collect event times of registered EventLists
+    width_samples.clear();
+    for (const auto* const bucket : buckets) {
+        for (auto* node = bucket; node != nullptr; node = node->next) {
+            width_samples.push_back(node->event_list.get_event_time());
+        }
+    }
+
+    if (width_samples.size() < 2) {
+        // not enough samples, keep the current width
+        return bucket_width;
+    }
+
+    // only the earliest EventLists matter, as they are dequeued first
+    const auto samples_count = std::min(width_samples.size(), width_samples_count);
+    std::partial_sort(width_samples.begin(), width_samples.begin() + samples_count, width_samples.end());
+
+    // average separation of the samples
+    const auto total_separation = width_samples[samples_count - 1] - width_samples[0];
+    const auto average_separation = total_separation / (samples_count - 1);
+
+    // recompute the average, ignoring separations larger than twice the average
+    auto trimmed_separation = EventTime{0};
+    auto trimmed_count = EventTime{0};
+    for (auto i = size_t{1}; i < samples_count; i++) {
+        const auto separation = width_samples[i] - width_samples[i - 1];
+        if (separation <= 2 * average_separation) {
+            trimmed_separation += separation;
+            trimmed_count++;
+        }
+    }
+
+    if (trimmed_count == 0) {
+        return std::max(EventTime{1}, 3 * average_separation);
+    }
+
+    // a bucket should cover about three EventLists
+    return std::max(EventTime{1}, 3 * trimmed_separation / trimmed_count);
+}
+
+void CalendarScheduler::resize(const size_t new_buckets_count) noexcept {
+    assert(new_buckets_count >= min_buckets_count);
+    assert((new_buckets_count & (new_buckets_count - 1)) == 0);
+
+    // estimate the new bucket width
+    const auto new_bucket_width = estimate_bucket_width();
+
+    // gather all EventLists into a single chain
+    auto* event_lists = Bucket{nullptr};
+    for (auto& bucket : buckets) {
+        while (bucket != nullptr) {
+            auto* const node = bucket;
+            bucket = node->next;
+            node->next = event_lists;
+            event_lists = node;
+        }
+    }
+
+    // re-hash the EventLists into the new calendar
+    bucket_width = new_bucket_width;
+    buckets.assign(new_buckets_count, nullptr);
+    while (event_lists != nullptr) {
+        auto* const node = event_lists;
+        event_lists = node->next;
+        insert_sorted(node);
+    }
+
+    // restore the current position of the calendar
+    current_bucket = bucket_index(last_time);
+    bucket_top = (last_time / bucket_width + 1) * bucket_width;
+}
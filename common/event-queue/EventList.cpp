@@ -9,11 +9,42 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalytical;
 
-EventList::EventList(const EventTime event_time) noexcept : event_time(event_time) {
+EventList::EventList(const EventTime event_time, NodePool* const node_pool) noexcept
+    : event_time(event_time),
+      node_pool(node_pool),
+      head(nullptr),
+      tail(nullptr) {
     assert(event_time >= 0);
+    assert(node_pool != nullptr);
+}
+
+EventList::EventList(EventList&& other) noexcept
+    : event_time(other.event_time),
+      node_pool(other.node_pool),
+      head(other.head),
+      tail(other.tail) {
+    // other no longer owns the events
+    other.head = nullptr;
+    other.tail = nullptr;
+}
+
+EventList& EventList::operator=(EventList&& other) noexcept {
+    if (this != &other) {
+        // drop registered events, then take over those of other
+        clear();
+        event_time = other.event_time;
+        node_pool = other.node_pool;
+        head = other.head;
+        tail = other.tail;
+        other.head = nullptr;
+        other.tail = nullptr;
+    }
+
+    return *this;
+}
 
-    // create an empty event list
-    events = std::list<Event>();
+EventList::~EventList() noexcept {
+    clear();
 }
 
 EventTime EventList::get_event_time() const noexcept {
@@ -23,15 +54,39 @@ EventTime EventList::get_event_time() const noexcept {
 void EventList::add_event(const Callback callback, const CallbackArg callback_arg) noexcept {
     assert(callback != nullptr);
 
-    // add the event to the event list
-    events.emplace_back(callback, callback_arg);
+    // add the event to the tail of the event list
+    auto* const node = node_pool->allocate(Node{Event(callback, callback_arg), nullptr});
+    if (tail == nullptr) {
+        head = node;
+    } else {
+        tail->next = node;
+    }
+    tail = node;
 }
 
 void EventList::invoke_events() noexcept {
     // invoke all events in the event list
-    while (!events.empty()) {
-        events.front().invoke_event();
-        // printf("\nEventQueue: issue event\n\n");
-        events.pop_front();
+    while (head != nullptr) {
+        // detach the first event and recycle its node
+        auto* const node = head;
+        head = node->next;
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+        const auto [callback, callback_arg] = node->event.get_handler_arg();
+        node_pool->release(node);
+
+        // invoke the event
+        (*callback)(callback_arg);
+    }
+}
+
+void EventList::clear() noexcept {
+    // return all nodes to the pool
+    while (head != nullptr) {
+        auto* const node = head;
+        head = node->next;
+        node_pool->release(node);
     }
+    tail = nullptr;
 }
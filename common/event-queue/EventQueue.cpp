@@ -9,9 +9,9 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalytical;
 
-EventQueue::EventQueue() noexcept : current_time(0) {
+EventQueue::EventQueue(const EventSchedulerPolicy policy) noexcept : current_time(0), scheduled_events_count(0) {
     // create empty event queue
-    event_queue = std::list<EventList>();
+    event_queue = EventScheduler::create(policy);
 }
 
 EventTime EventQueue::get_current_time() const noexcept {
@@ -20,7 +20,14 @@ EventTime EventQueue::get_current_time() const noexcept {
 
 bool EventQueue::finished() const noexcept {
     // check whether event queue is empty
-    return event_queue.empty();
+    return event_queue->empty();
+}
+
+EventTime EventQueue::get_next_event_time() const noexcept {
+    // next event should exist
+    assert(!finished());
+
+    return event_queue->front_time();
 }
 
 void EventQueue::proceed() noexcept {
@@ -28,13 +35,9 @@ void EventQueue::proceed() noexcept {
     assert(!finished());
 
     // proceed to the next event time
-    //auto& current_event_list = event_queue.front();
-    // if (!current_event_list.is_empty()) {
-    //     current_event_list.invoke_events();
-    // }
-    
-    EventList current_event_list = event_queue.front();
-    event_queue.pop_front();
+    // events scheduled at the current time while invoking this list
+    // are grouped into a new EventList, which is invoked by the next proceed()
+    auto current_event_list = event_queue->pop();
 
     // check the validity and update current time
     // if(current_event_list.get_event_time() <= current_time) {
@@ -57,26 +60,11 @@ void EventQueue::schedule_event(const EventTime event_time,
     // time should be at least larger than current time
     assert(event_time >= current_time);
 
-    // find the entry to insert event
-    auto event_list_it = event_queue.begin();
-    while (event_list_it != event_queue.end() && event_list_it->get_event_time() < event_time) {
-        event_list_it++;
-    }
-
-    // There can be three scenarios:
-    // (1) event list matching with event_time is found
-    // (2) there's no event list matching with event_time
-    //   (2-1) the event_time requested is
-    //   larger than the largest event time scheduled
-    //   (2-2) the event_time requested is
-    //   smaller than the largest event time scheduled
-    // for both (2-1) or (2-2), a new event should be created
-    if (event_list_it == event_queue.end() || event_time < event_list_it->get_event_time()) {
-        // insert new event_list
-        event_list_it = event_queue.insert(event_list_it, EventList(event_time));
-    }
+    // register the event, grouping it with the other events of the same event time
+    event_queue->schedule(event_time, callback, callback_arg);
+    scheduled_events_count++;
+}
 
-    // now, whether (1) or (2), the entry to insert the event is found
-    // add event to event_list
-    event_list_it->add_event(callback, callback_arg);
+uint64_t EventQueue::get_scheduled_events_count() const noexcept {
+    return scheduled_events_count;
 }
@@ -0,0 +1,34 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventScheduler.h"
+#include "common/BinaryHeapScheduler.h"
+#include "common/CalendarScheduler.h"
+#include "common/ListScheduler.h"
+#include "common/RadixHeapScheduler.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+std::unique_ptr<EventScheduler> EventScheduler::create(const EventSchedulerPolicy policy) noexcept {
+    switch (policy) {
+    case EventSchedulerPolicy::List:
+        return std::make_unique<ListScheduler>();
+    case EventSchedulerPolicy::BinaryHeap:
+        return std::make_unique<BinaryHeapScheduler>();
+    case EventSchedulerPolicy::RadixHeap:
+        return std::make_unique<RadixHeapScheduler>();
+    case EventSchedulerPolicy::Calendar:
+        return std::make_unique<CalendarScheduler>();
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical) " << "not supported event scheduler policy" << std::endl;
+        std::exit(-1);
+    }
+}
+
+// default destructor
+EventScheduler::~EventScheduler() noexcept = default;
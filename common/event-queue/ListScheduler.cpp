@@ -0,0 +1,63 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/ListScheduler.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+ListScheduler::ListScheduler() noexcept : head(nullptr) {}
+
+bool ListScheduler::empty() const noexcept {
+    return head == nullptr;
+}
+
+EventTime ListScheduler::front_time() const noexcept {
+    assert(!empty());
+
+    // EventLists are sorted, so the first one is the earliest
+    return head->event_list.get_event_time();
+}
+
+void ListScheduler::schedule(const EventTime event_time,
+                             const Callback callback,
+                             const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // find the entry to insert event
+    auto* link = &head;
+    while (*link != nullptr && (*link)->event_list.get_event_time() < event_time) {
+        link = &(*link)->next;
+    }
+
+    // There can be three scenarios:
+    // (1) event list matching with event_time is found
+    // (2) there's no event list matching with event_time
+    //   (2-1) the event_time requested is
+    //   larger than the largest event time scheduled
+    //   (2-2) the event_time requested is
+    //   smaller than the largest event time scheduled
+    // for both (2-1) or (2-2), a new event should be created
+    if (*link == nullptr || event_time < (*link)->event_list.get_event_time()) {
+        // insert new event_list
+        *link = event_list_node_pool.allocate(EventListNode{EventList(event_time, &event_node_pool), *link});
+    }
+
+    // now, whether (1) or (2), the entry to insert the event is found
+    // add event to event_list
+    (*link)->event_list.add_event(callback, callback_arg);
+}
+
+EventList ListScheduler::pop() noexcept {
+    assert(!empty());
+
+    // dequeue the first EventList
+    auto* const node = head;
+    head = node->next;
+    auto event_list = std::move(node->event_list);
+    event_list_node_pool.release(node);
+
+    return event_list;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/RadixHeapScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+RadixHeapScheduler::RadixHeapScheduler() noexcept : last_time(0), events_count(0) {}
+
+bool RadixHeapScheduler::empty() const noexcept {
+    return events_count == 0;
+}
+
+EventTime RadixHeapScheduler::front_time() const noexcept {
+    assert(!empty());
+
+    if (buckets[0].head != nullptr) {
+        // bucket 0 holds events at the last popped time
+        return last_time;
+    }
+
+    // otherwise, the earliest event lies in the first non-empty bucket
+    auto index = size_t{1};
+    while (buckets[index].head == nullptr) {
+        index++;
+    }
+    assert(index < buckets_count);
+
+    auto earliest_time = buckets[index].head->event_time;
+    for (auto* entry = buckets[index].head->next; entry != nullptr; entry = entry->next) {
+        earliest_time = std::min(earliest_time, entry->event_time);
+    }
+    return earliest_time;
+}
+
+void RadixHeapScheduler::schedule(const EventTime event_time,
+                                  const Callback callback,
+                                  const CallbackArg callback_arg) noexcept {
+    // radix heap requires monotone keys
+    assert(event_time >= last_time);
+    assert(callback != nullptr);
+
+    // append the event to its bucket
+    append(entry_pool.allocate(BucketEntry{event_time, Event(callback, callback_arg), nullptr}));
+    events_count++;
+}
+
+EventList RadixHeapScheduler::pop() noexcept {
+    assert(!empty());
+
+    if (buckets[0].head == nullptr) {
+        // find the first non-empty bucket
+        auto index = size_t{1};
+        while (buckets[index].head == nullptr) {
+            index++;
+        }
+        assert(index < buckets_count);
+
+        // the smallest event time in the bucket becomes the new last time
+        auto* entry = buckets[index].head;
+        buckets[index] = Bucket();
+        last_time = entry->event_time;
+        for (auto* other = entry->next; other != nullptr; other = other->next) {
+            last_time = std::min(last_time, other->event_time);
+        }
+
+        // redistribute the events into lower buckets, preserving their order
+        while (entry != nullptr) {
+            auto* const next = entry->next;
+            assert(bucket_index(entry->event_time) < index);
+            append(entry);
+            entry = next;
+        }
+    }
+
+    // bucket 0 holds every event scheduled at last_time, in scheduling order
+    auto* entry = buckets[0].head;
+    buckets[0] = Bucket();
+    auto event_list = EventList(last_time, &event_node_pool);
+    while (entry != nullptr) {
+        auto* const next = entry->next;
+        const auto [callback, callback_arg] = entry->event.get_handler_arg();
+        event_list.add_event(callback, callback_arg);
+        entry_pool.release(entry);
+        events_count--;
+        entry = next;
+    }
+
+    return event_list;
+}
+
+size_t RadixHeapScheduler::bucket_index(const EventTime event_time) const noexcept {
+    assert(event_time >= last_time);
+
+    // bucket index is the position of the most significant bit differing from last_time
+    const auto difference = event_time ^ last_time;
+    if (difference == 0) {
+        return 0;
+    }
+
+    return static_cast<size_t>(64 - __builtin_clzll(difference));
+}
+
+void RadixHeapScheduler::append(BucketEntry* const entry) noexcept {
+    assert(entry != nullptr);
+
+    // link the entry to the back of its bucket
+    auto& bucket = buckets[bucket_index(entry->event_time)];
+    entry->next = nullptr;
+    if (bucket.tail == nullptr) {
+        bucket.head = entry;
+    } else {
+        bucket.tail->next = entry;
+    }
+    bucket.tail = entry;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CollectiveParser.h"
+
+using namespace NetworkAnalytical;
+
+std::optional<CollectiveType> NetworkAnalytical::parse_collective_type(const std::string& name) noexcept {
+    if (name == "AllReduce") {
+        return CollectiveType::AllReduce;
+    }
+
+    if (name == "ReduceScatter") {
+        return CollectiveType::ReduceScatter;
+    }
+
+    if (name == "AllGather") {
+        return CollectiveType::AllGather;
+    }
+
+    if (name == "AllToAll") {
+        return CollectiveType::AllToAll;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<CollectiveAlgorithm> NetworkAnalytical::parse_collective_algorithm(const std::string& name) noexcept {
+    if (name == "Ring") {
+        return CollectiveAlgorithm::Ring;
+    }
+
+    if (name == "Direct") {
+        return CollectiveAlgorithm::Direct;
+    }
+
+    if (name == "HalvingDoubling") {
+        return CollectiveAlgorithm::HalvingDoubling;
+    }
+
+    if (name == "Hierarchical") {
+        return CollectiveAlgorithm::Hierarchical;
+    }
+
+    return std::nullopt;
+}
@@ -6,10 +6,11 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkParser.h"
 #include <cassert>
 #include <iostream>
+#include <sstream>
 
 using namespace NetworkAnalytical;
 
-NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1) {
+NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1), reconfig_time(0) {
     // initialize values
     npus_count_per_dim = {};
     bandwidth_per_dim = {};
@@ -22,10 +23,24 @@ NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1)
 
         // parse network configs
         parse_network_config_yml(network_config);
-    } catch (const YAML::BadFile& e) {
+    } catch (const YAML::Exception& e) {
         // loading network config file failed
         std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
         std::exit(-1);
+    } catch (const NetworkConfigError& e) {
+        // invalid network config
+        std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
+        std::exit(-1);
+    }
+}
+
+NetworkParser::NetworkParser(const YAML::Node& network_config) : dims_count(-1), reconfig_time(0) {
+    try {
+        // parse network configs
+        parse_network_config_yml(network_config);
+    } catch (const YAML::Exception& e) {
+        // the node isn't a network config
+        throw NetworkConfigError(e.what());
     }
 }
 
@@ -69,7 +84,7 @@ std::vector<TopologyBuildingBlock> NetworkParser::get_topologies_per_dim() const
     return topology_per_dim;
 }
 
-void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) noexcept {
+void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) {
     // parse topology_per_dim
     const auto topology_names = parse_vector<std::string>(network_config["topology"]);
     for (const auto& topology_name : topology_names) {
@@ -87,8 +102,7 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
     
     std::vector<Latency> reconfig_times = parse_vector<Latency>(network_config["reconfig_time"]);
     if (reconfig_times.size() > 1) {
-        std::cerr << "[Error] (network/analytical) " << "\"reconfig_time\" should be a single value" << std::endl;
-        std::exit(-1);
+        throw NetworkConfigError("\"reconfig_time\" should be a single value");
     } else if (reconfig_times.size() == 1) {
         reconfig_time = parse_vector<Latency>(network_config["reconfig_time"])[0];
     }
@@ -97,9 +111,7 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
     check_validity();
 }
 
-TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topology_name) noexcept {
-    assert(!topology_name.empty());
-
+TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topology_name) {
     if (topology_name == "Ring") {
         return TopologyBuildingBlock::Ring;
     }
@@ -116,55 +128,62 @@ TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topo
         return TopologyBuildingBlock::Reconfig;
     }
 
-    // shouldn't reach here
-    std::cerr << "[Error] (network/analytical) " << "Topology name " << topology_name << " not supported" << std::endl;
-    std::exit(-1);
+    // unknown topology name
+    throw NetworkConfigError("Topology name " + topology_name + " not supported");
 }
 
-void NetworkParser::check_validity() const noexcept {
+void NetworkParser::check_validity() const {
+    // there should be at least one dimension
+    if (dims_count <= 0) {
+        throw NetworkConfigError("topology should have at least one dimension");
+    }
+
     // dims_count should match
     if (dims_count != npus_count_per_dim.size()) {
-        std::cerr << "[Error] (network/analytical) " << "length of npus_count (" << npus_count_per_dim.size()
-                  << ") doesn't match with dimensions (" << dims_count << ")" << std::endl;
-        std::exit(-1);
+        auto message = std::ostringstream();
+        message << "length of npus_count (" << npus_count_per_dim.size() << ") doesn't match with dimensions ("
+                << dims_count << ")";
+        throw NetworkConfigError(message.str());
     }
 
     if (dims_count != bandwidth_per_dim.size()) {
-        std::cerr << "[Error] (network/analytical) " << "length of bandwidth (" << bandwidth_per_dim.size()
-                  << ") doesn't match with dims_count (" << dims_count << ")" << std::endl;
-        std::exit(-1);
+        auto message = std::ostringstream();
+        message << "length of bandwidth (" << bandwidth_per_dim.size() << ") doesn't match with dims_count ("
+                << dims_count << ")";
+        throw NetworkConfigError(message.str());
     }
 
     if (dims_count != latency_per_dim.size()) {
-        std::cerr << "[Error] (network/analytical) " << "length of latency (" << latency_per_dim.size()
-                  << ") doesn't match with dims_count (" << dims_count << ")" << std::endl;
-        std::exit(-1);
+        auto message = std::ostringstream();
+        message << "length of latency (" << latency_per_dim.size() << ") doesn't match with dims_count ("
+                << dims_count << ")";
+        throw NetworkConfigError(message.str());
     }
 
     // npus_count should be all positive
     for (const auto& npus_count : npus_count_per_dim) {
         if (npus_count <= 1) {
-            std::cerr << "[Error] (network/analytical) " << "npus_count (" << npus_count << ") should be larger than 1"
-                      << std::endl;
-            std::exit(-1);
+            auto message = std::ostringstream();
+            message << "npus_count (" << npus_count << ") should be larger than 1";
+            throw NetworkConfigError(message.str());
         }
     }
 
     // bandwidths should be all positive
     for (const auto& bandwidth : bandwidth_per_dim) {
         if (bandwidth <= 0) {
-            std::cerr << "[Error] (network/analytical) " << "bandwidth (" << bandwidth << ") should be larger than 0"
-                      << std::endl;
-            std::exit(-1);
+            auto message = std::ostringstream();
+            message << "bandwidth (" << bandwidth << ") should be larger than 0";
+            throw NetworkConfigError(message.str());
         }
     }
 
     // latency should be non-negative
     for (const auto& latency : latency_per_dim) {
         if (latency < 0) {
-            std::cerr << "[Error] (network/analytical) " << "latency (" << latency << ") should be non-negative"
-                      << std::endl;
-            std::exit(-1);
+            auto message = std::ostringstream();
+            message << "latency (" << latency << ") should be non-negative";
+            throw NetworkConfigError(message.str());
         }
     }
 }
@@ -0,0 +1,156 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/LinkTelemetry.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+size_t LinkTelemetry::histogram_bucket(const EventTime queueing_delay) noexcept {
+    // bucket i counts delays of i significant bits
+    auto bucket = size_t{0};
+    for (auto delay = queueing_delay; delay > 0; delay >>= 1) {
+        bucket++;
+    }
+    return std::min(bucket, histogram_buckets_count - 1);
+}
+
+LinkTelemetry::LinkTelemetry() noexcept
+    : bytes(0),
+      chunks_count(0),
+      busy_time(0),
+      total_queueing_delay(0),
+      queue_depth(0),
+      max_queue_depth(0),
+      last_queue_change_time(0),
+      queue_depth_area(0),
+      queueing_delay_histogram() {}
+
+void LinkTelemetry::record_transmission(const EventTime ready_time,
+                                        const EventTime start_time,
+                                        const EventTime end_time,
+                                        const ChunkSize chunk_size) noexcept {
+    assert(ready_time <= start_time && start_time <= end_time);
+
+    bytes += chunk_size;
+    chunks_count++;
+    busy_time += end_time - start_time;
+    total_queueing_delay += start_time - ready_time;
+    queueing_delay_histogram[histogram_bucket(start_time - ready_time)]++;
+}
+
+void LinkTelemetry::cancel_transmission(const EventTime ready_time,
+                                        const EventTime start_time,
+                                        const EventTime end_time,
+                                        const ChunkSize chunk_size) noexcept {
+    assert(ready_time <= start_time && start_time <= end_time);
+    assert(chunks_count > 0);
+
+    bytes -= chunk_size;
+    chunks_count--;
+    busy_time -= end_time - start_time;
+    total_queueing_delay -= start_time - ready_time;
+    queueing_delay_histogram[histogram_bucket(start_time - ready_time)]--;
+}
+
+void LinkTelemetry::record_queue_depth(const EventTime time, const size_t queue_depth) noexcept {
+    assert(time >= last_queue_change_time);
+
+    // accumulate the previous depth over the time it lasted
+    queue_depth_area += static_cast<double>(this->queue_depth) * static_cast<double>(time - last_queue_change_time);
+    last_queue_change_time = time;
+    this->queue_depth = queue_depth;
+    max_queue_depth = std::max(max_queue_depth, queue_depth);
+}
+
+uint64_t LinkTelemetry::get_bytes() const noexcept {
+    return bytes;
+}
+
+uint64_t LinkTelemetry::get_chunks_count() const noexcept {
+    return chunks_count;
+}
+
+EventTime LinkTelemetry::get_busy_time() const noexcept {
+    return busy_time;
+}
+
+size_t LinkTelemetry::get_queue_depth() const noexcept {
+    return queue_depth;
+}
+
+size_t LinkTelemetry::get_max_queue_depth() const noexcept {
+    return max_queue_depth;
+}
+
+double LinkTelemetry::get_mean_queue_depth(const EventTime end_time) const noexcept {
+    assert(end_time >= last_queue_change_time);
+
+    if (end_time == 0) {
+        return 0;
+    }
+
+    const auto area =
+        queue_depth_area + static_cast<double>(queue_depth) * static_cast<double>(end_time - last_queue_change_time);
+    return area / static_cast<double>(end_time);
+}
+
+double LinkTelemetry::get_mean_queueing_delay() const noexcept {
+    if (chunks_count == 0) {
+        return 0;
+    }
+
+    return static_cast<double>(total_queueing_delay) / static_cast<double>(chunks_count);
+}
+
+const std::array<uint64_t, LinkTelemetry::histogram_buckets_count>& LinkTelemetry::get_queueing_delay_histogram()
+    const noexcept {
+    return queueing_delay_histogram;
+}
+
+void NetworkAnalytical::write_link_telemetry_csv(const std::vector<LinkTelemetryEntry>& entries,
+                                                 const EventTime end_time,
+                                                 std::ostream& output) noexcept {
+    // the histogram is a single column, bucket counts separated by spaces
+    output << "src,dest,bytes,chunks,busy_time_ns,utilization,max_queue_depth,mean_queue_depth,"
+           << "mean_queueing_delay_ns,queueing_delay_histogram\n";
+    for (const auto& [src, dest, telemetry] : entries) {
+        const auto utilization =
+            (end_time == 0) ? 0.0 : static_cast<double>(telemetry.get_busy_time()) / static_cast<double>(end_time);
+        output << src << "," << dest << "," << telemetry.get_bytes() << "," << telemetry.get_chunks_count() << ","
+               << telemetry.get_busy_time() << "," << utilization << "," << telemetry.get_max_queue_depth() << ","
+               << telemetry.get_mean_queue_depth(end_time) << "," << telemetry.get_mean_queueing_delay() << ",";
+        const auto& histogram = telemetry.get_queueing_delay_histogram();
+        for (auto bucket = size_t{0}; bucket < histogram.size(); bucket++) {
+            output << (bucket == 0 ? "" : " ") << histogram[bucket];
+        }
+        output << "\n";
+    }
+}
+
+void NetworkAnalytical::write_link_telemetry_json(const std::vector<LinkTelemetryEntry>& entries,
+                                                  const EventTime end_time,
+                                                  std::ostream& output) noexcept {
+    output << "[";
+    for (auto i = size_t{0}; i < entries.size(); i++) {
+        const auto& [src, dest, telemetry] = entries[i];
+        const auto utilization =
+            (end_time == 0) ? 0.0 : static_cast<double>(telemetry.get_busy_time()) / static_cast<double>(end_time);
+        output << (i == 0 ? "\n" : ",\n") << "  {\"src\": " << src << ", \"dest\": " << dest
+               << ", \"bytes\": " << telemetry.get_bytes() << ", \"chunks\": " << telemetry.get_chunks_count()
+               << ", \"busy_time_ns\": " << telemetry.get_busy_time() << ", \"utilization\": " << utilization
+               << ", \"max_queue_depth\": " << telemetry.get_max_queue_depth()
+               << ", \"mean_queue_depth\": " << telemetry.get_mean_queue_depth(end_time)
+               << ", \"mean_queueing_delay_ns\": " << telemetry.get_mean_queueing_delay()
+               << ", \"queueing_delay_histogram\": [";
+        const auto& histogram = telemetry.get_queueing_delay_histogram();
+        for (auto bucket = size_t{0}; bucket < histogram.size(); bucket++) {
+            output << (bucket == 0 ? "" : ", ") << histogram[bucket];
+        }
+        output << "]}";
+    }
+    output << "\n]\n";
+}
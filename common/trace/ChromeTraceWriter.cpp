@@ -0,0 +1,145 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/ChromeTraceWriter.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+ChromeTraceWriter::ChromeTraceWriter(const std::string& path) noexcept
+    : file(std::make_unique<std::ofstream>(path)),
+      output(file.get()),
+      events_count(0),
+      hops_count(0),
+      closed(false) {
+    if (!*file) {
+        std::cerr << "[Error] (network/analytical/trace) " << "cannot open " << path << std::endl;
+        std::exit(-1);
+    }
+
+    buffer.reserve(buffer_size);
+    buffer += "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+}
+
+ChromeTraceWriter::ChromeTraceWriter(std::ostream& output) noexcept
+    : file(nullptr),
+      output(&output),
+      events_count(0),
+      hops_count(0),
+      closed(false) {
+    buffer.reserve(buffer_size);
+    buffer += "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() noexcept {
+    close();
+}
+
+void ChromeTraceWriter::record(const ChunkHopRecord& hop) noexcept {
+    assert(hop.ready_time <= hop.start_time && hop.start_time <= hop.end_time && hop.end_time <= hop.arrival_time);
+
+    const auto lock = std::lock_guard(mutex);
+    if (closed) {
+        return;
+    }
+
+    name_track(hop.src, hop.dest);
+    const auto chunk_args = ", \"args\": {\"chunk_src\": " + std::to_string(hop.chunk_src) +
+                            ", \"chunk_dest\": " + std::to_string(hop.chunk_dest) +
+                            ", \"size\": " + std::to_string(hop.chunk_size);
+
+    // the chunk reaches the link
+    append_event("enqueue", "i", hop.ready_time, hop.src, hop.dest);
+    buffer += ", \"s\": \"t\"";
+    buffer += chunk_args;
+    buffer += "}}";
+
+    // the link is busy serializing the chunk
+    append_event("transmission", "X", hop.start_time, hop.src, hop.dest);
+    buffer += ", \"dur\": ";
+    append_time(hop.end_time - hop.start_time);
+    buffer += chunk_args;
+    buffer += ", \"queueing_delay_ns\": " + std::to_string(hop.start_time - hop.ready_time) + "}}";
+
+    // the chunk reaches the next device
+    append_event("arrival", "i", hop.arrival_time, hop.src, hop.dest);
+    buffer += ", \"s\": \"t\"";
+    buffer += chunk_args;
+    buffer += "}}";
+
+    hops_count++;
+    if (buffer.size() >= buffer_size) {
+        flush();
+    }
+}
+
+void ChromeTraceWriter::close() noexcept {
+    const auto lock = std::lock_guard(mutex);
+    if (closed) {
+        return;
+    }
+
+    buffer += "\n]}\n";
+    flush();
+    output->flush();
+    closed = true;
+}
+
+uint64_t ChromeTraceWriter::get_hops_count() const noexcept {
+    const auto lock = std::lock_guard(mutex);
+    return hops_count;
+}
+
+void ChromeTraceWriter::name_track(const DeviceId src, const DeviceId dest) noexcept {
+    if (named_devices.insert(src).second) {
+        begin_event();
+        buffer += "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " + std::to_string(src) +
+                  ", \"args\": {\"name\": \"device " + std::to_string(src) + "\"}}";
+    }
+
+    const auto link_key = (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dest);
+    if (named_links.insert(link_key).second) {
+        begin_event();
+        buffer += "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " + std::to_string(src) +
+                  ", \"tid\": " + std::to_string(dest) + ", \"args\": {\"name\": \"link " + std::to_string(src) +
+                  " -> " + std::to_string(dest) + "\"}}";
+    }
+}
+
+void ChromeTraceWriter::append_event(const char* const name,
+                                     const char* const phase,
+                                     const EventTime time,
+                                     const DeviceId src,
+                                     const DeviceId dest) noexcept {
+    begin_event();
+    buffer += "{\"name\": \"";
+    buffer += name;
+    buffer += "\", \"ph\": \"";
+    buffer += phase;
+    buffer += "\", \"ts\": ";
+    append_time(time);
+    buffer += ", \"pid\": " + std::to_string(src) + ", \"tid\": " + std::to_string(dest);
+}
+
+void ChromeTraceWriter::begin_event() noexcept {
+    // one event per line, separated by commas
+    buffer += (events_count == 0) ? "\n" : ",\n";
+    events_count++;
+}
+
+void ChromeTraceWriter::append_time(const EventTime time) noexcept {
+    // ns as us with three decimals, exactly
+    const auto fraction = std::to_string(1000 + time % 1000);
+    buffer += std::to_string(time / 1000);
+    buffer += ".";
+    buffer += fraction.substr(1);
+}
+
+void ChromeTraceWriter::flush() noexcept {
+    output->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
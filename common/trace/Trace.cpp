@@ -0,0 +1,188 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Trace.h"
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/// identifies binary trace files
+constexpr char trace_magic[8] = {'A', 'N', 'T', 'R', 'A', 'C', 'E', '1'};
+
+/**
+ * Header of a binary trace file, followed by its records.
+ */
+struct TraceFileHeader {
+    /// trace_magic
+    char magic[8];
+
+    /// size of each record, checked by the decoder
+    uint64_t record_size;
+
+    /// number of records in the file
+    uint64_t records_count;
+
+    /// number of records overwritten before the file was written
+    uint64_t dropped_count;
+};
+
+/**
+ * How the decoder prints an argument of a trace event.
+ */
+enum class TraceArgKind { None, Int, Double };
+
+/**
+ * Names and kinds of the arguments of a trace event.
+ */
+struct TraceEventInfo {
+    /// name of the event
+    const char* name;
+
+    /// name of each argument
+    const char* arg_names[4];
+
+    /// kind of each argument
+    TraceArgKind arg_kinds[4];
+};
+
+constexpr auto None = TraceArgKind::None;
+constexpr auto Int = TraceArgKind::Int;
+constexpr auto Double = TraceArgKind::Double;
+
+/// decoding information of every event, indexed by TraceEvent
+constexpr TraceEventInfo trace_event_infos[] = {
+    {"LinkBecameFree", {"pending_chunks"}, {Int, None, None, None}},
+    {"ChunkTransmissionScheduled", {"src", "dest", "size", "hop"}, {Int, Int, Int, Int}},
+    {"ChunkQueued", {"src", "dest", "pending_chunks"}, {Int, Int, Int, None}},
+    {"LinkIdle", {"src", "dest", "pending_chunks"}, {Int, Int, Int, None}},
+    {"LinkReconfigured", {"src", "dest", "bandwidth", "pending_chunks"}, {Int, Int, Double, Int}},
+    {"LinkReconfigurationSkipped", {"bandwidth", "latency"}, {Double, Double, None, None}},
+    {"ChunkRouted", {"src", "dest", "topology_iteration", "hops"}, {Int, Int, Int, Int}},
+    {"CircuitSchedulesLoaded", {"schedules"}, {Int, None, None, None}},
+    {"ReconfigurationRequested", {"topo_id", "devices", "npus", "inflight_collectives"}, {Int, Int, Int, Int}},
+    {"ReconfigurationDeferred", {"topo_id", "inflight_collectives", "reconfiguring"}, {Int, Int, Int, None}},
+    {"ReconfigurationIgnored", {"topo_id"}, {Int, None, None, None}},
+    {"NetworkDrained", {"topology_iteration"}, {Int, None, None, None}},
+};
+
+static_assert(sizeof(trace_event_infos) / sizeof(trace_event_infos[0]) ==
+                  static_cast<size_t>(TraceEvent::EventsCount),
+              "every trace event has decoding information");
+
+/// name of every category, indexed by TraceCategory
+constexpr const char* trace_category_names[] = {"Link", "Device", "Topology"};
+
+}  // namespace
+
+TraceBuffer& TraceBuffer::get() noexcept {
+    static auto buffer = TraceBuffer(ANALYTICAL_TRACE_BUFFER_SIZE);
+    return buffer;
+}
+
+TraceBuffer::TraceBuffer(const size_t capacity) noexcept
+    : records(capacity),
+      mask(capacity - 1),
+      next_index(0) {
+    assert(capacity > 0);
+    assert((capacity & (capacity - 1)) == 0);
+}
+
+void TraceBuffer::record(const TraceRecord& record) noexcept {
+    // claim a slot, the oldest record is overwritten once the buffer wraps around
+    const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+    records[index & mask] = record;
+}
+
+std::vector<TraceRecord> TraceBuffer::snapshot() const noexcept {
+    const auto records_count = get_records_count();
+    const auto first_index = records_count - std::min<uint64_t>(records_count, records.size());
+
+    auto held_records = std::vector<TraceRecord>();
+    held_records.reserve(records_count - first_index);
+    for (auto index = first_index; index < records_count; index++) {
+        held_records.push_back(records[index & mask]);
+    }
+    return held_records;
+}
+
+uint64_t TraceBuffer::get_records_count() const noexcept {
+    return next_index.load(std::memory_order_acquire);
+}
+
+uint64_t TraceBuffer::get_dropped_count() const noexcept {
+    const auto records_count = get_records_count();
+    return records_count - std::min<uint64_t>(records_count, records.size());
+}
+
+void TraceBuffer::clear() noexcept {
+    next_index.store(0, std::memory_order_release);
+}
+
+bool TraceBuffer::dump(const std::string& path) const noexcept {
+    const auto held_records = snapshot();
+
+    auto header = TraceFileHeader{};
+    std::memcpy(header.magic, trace_magic, sizeof(trace_magic));
+    header.record_size = sizeof(TraceRecord);
+    header.records_count = held_records.size();
+    header.dropped_count = get_dropped_count();
+
+    auto file = std::ofstream(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(held_records.data()),
+               static_cast<std::streamsize>(held_records.size() * sizeof(TraceRecord)));
+    return static_cast<bool>(file);
+}
+
+bool NetworkAnalytical::decode_trace(std::istream& input, std::ostream& output) noexcept {
+    // check the header
+    auto header = TraceFileHeader{};
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, trace_magic, sizeof(trace_magic)) != 0 ||
+        header.record_size != sizeof(TraceRecord)) {
+        return false;
+    }
+    if (header.dropped_count > 0) {
+        output << "# " << header.dropped_count << " earlier records were dropped" << std::endl;
+    }
+
+    // print each record as: time [category/level] event arg=value ...
+    for (auto i = uint64_t{0}; i < header.records_count; i++) {
+        auto record = TraceRecord{};
+        if (!input.read(reinterpret_cast<char*>(&record), sizeof(record)) ||
+            record.event >= TraceEvent::EventsCount) {
+            return false;
+        }
+
+        const auto& info = trace_event_infos[static_cast<size_t>(record.event)];
+        const auto* const category_name = trace_category_names[static_cast<size_t>(trace_category(record.event))];
+        const auto* const level_name = (record.level == TraceLevel::Info) ? "Info" : "Debug";
+        output << record.time << " [" << category_name << "/" << level_name << "] " << info.name;
+        for (auto arg = 0; arg < 4; arg++) {
+            switch (info.arg_kinds[arg]) {
+            case TraceArgKind::Int:
+                output << " " << info.arg_names[arg] << "=" << static_cast<int64_t>(record.args[arg]);
+                break;
+            case TraceArgKind::Double: {
+                auto value = 0.0;
+                std::memcpy(&value, &record.args[arg], sizeof(value));
+                output << " " << info.arg_names[arg] << "=" << value;
+                break;
+            }
+            case TraceArgKind::None:
+                break;
+            }
+        }
+        output << "\n";
+    }
+    return static_cast<bool>(output);
+}
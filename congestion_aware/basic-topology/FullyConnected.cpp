@@ -18,13 +18,11 @@ FullyConnected::FullyConnected(const int npus_count, const Bandwidth bandwidth,
     basic_topology_type = TopologyBuildingBlock::FullyConnected;
 
     // fully-connect every src-dest pairs
-    for (auto src = 0; src < npus_count; src++) {
-        for (auto dest = 0; dest < npus_count; dest++) {
-            if (src != dest) {
-                connect(src, dest, bandwidth, latency, false);
-            }
-        }
-    }
+    // links are materialized on first use, as most workloads only exercise a fraction of the N^2 pairs
+    connect_all_pairs(bandwidth, latency);
+
+    // construct the links
+    build_links();
 }
 
 Route FullyConnected::route(const DeviceId src, const DeviceId dest) const noexcept {
@@ -34,9 +32,5 @@ Route FullyConnected::route(const DeviceId src, const DeviceId dest) const noexc
 
     // construct route
     // directly connected
-    auto route = Route();
-    route.push_back(devices[src]);
-    route.push_back(devices[dest]);
-
-    return route;
+    return Route{src, dest};
 }
@@ -20,6 +20,9 @@ Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latenc
         connect(i, i + 1, bandwidth, latency, bidirectional);
     }
     connect(npus_count - 1, 0, bandwidth, latency, bidirectional);
+
+    // construct the links
+    build_links();
 }
 
 Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
@@ -27,29 +30,32 @@ Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
 
-    // construct empty route
-    auto route = Route();
-
     auto step = 1;  // default direction: clockwise
+    auto clockwise_dist = dest - src;
+    if (clockwise_dist < 0) {
+        clockwise_dist += npus_count;
+    }
+    auto hops_count = clockwise_dist;
     if (bidirectional) {
         // check whether going anticlockwise is shorter
-        auto clockwise_dist = dest - src;
-        if (clockwise_dist < 0) {
-            clockwise_dist += npus_count;
-        }
         const auto anticlockwise_dist = npus_count - clockwise_dist;
 
         if (anticlockwise_dist < clockwise_dist) {
             // traverse the ring anticlockwise
             step = -1;
+            hops_count = anticlockwise_dist;
         }
     }
 
+    // construct empty route, sized for every hop and the dest
+    auto route = Route();
+    route.reserve(hops_count + 1);
+
     // construct the route
     auto current = src;
     while (current != dest) {
         // traverse the ring until reaches dest
-        route.push_back(devices[current]);
+        route.push_back(current);
         current = (current + step);
 
         // wrap around
@@ -61,7 +67,7 @@ Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
     }
 
     // arrives at dest
-    route.push_back(devices[dest]);
+    route.push_back(dest);
 
     // return the constructed route
     return route;
@@ -23,6 +23,9 @@ Switch::Switch(const int npus_count, const Bandwidth bandwidth, const Latency la
     for (auto i = 0; i < npus_count; i++) {
         connect(i, switch_id, bandwidth, latency, true);
     }
+
+    // construct the links
+    build_links();
 }
 
 Route Switch::route(DeviceId src, DeviceId dest) const noexcept {
@@ -32,10 +35,5 @@ Route Switch::route(DeviceId src, DeviceId dest) const noexcept {
 
     // construct route
     // start at source, and go to switch, then go to destination
-    auto route = Route();
-    route.push_back(devices[src]);
-    route.push_back(devices[switch_id]);
-    route.push_back(devices[dest]);
-
-    return route;
+    return Route{src, switch_id, dest};
 }
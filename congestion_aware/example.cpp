@@ -43,7 +43,7 @@ int main() {
             }
 
             // crate a chunk
-            auto route = topology->route(i, j);
+            auto route = topology->cached_route(i, j);
             auto* event_queue_ptr = static_cast<void*>(event_queue.get());
             auto chunk = std::make_unique<Chunk>(chunk_size, route, chunk_arrived_callback, event_queue_ptr);
 
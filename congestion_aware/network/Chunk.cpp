@@ -5,7 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
-#include "congestion_aware/Link.h"
+#include "congestion_aware/Topology.h"
 #include <cassert>
 #include <stdio.h>
 
@@ -26,36 +26,94 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
         chunk->invoke_callback();
     } else {
         // send this chunk to next dest
-        const auto current_node = chunk->current_device();
+        auto* const current_node = chunk->current_device();
         current_node->send(std::move(chunk));  // send chunk to next des
     }
 }
 
+void* Chunk::operator new(const size_t size) {
+    // chunks are never derived, so the pool serves every allocation
+    assert(size == sizeof(Chunk));
+
+    return ChunkPool::allocate();
+}
+
+void Chunk::operator delete(void* const chunk_ptr) noexcept {
+    if (chunk_ptr == nullptr) {
+        return;
+    }
+
+    ChunkPool::release(chunk_ptr);
+}
+
 Chunk::Chunk(const ChunkSize chunk_size, Route route, const Callback callback, const CallbackArg callback_arg) noexcept
+    : Chunk(chunk_size, std::make_shared<const Route>(std::move(route)), callback, callback_arg) {}
+
+Chunk::Chunk(const ChunkSize chunk_size,
+             std::shared_ptr<const Route> route,
+             const Callback callback,
+             const CallbackArg callback_arg) noexcept
     : chunk_size(chunk_size),
       route(std::move(route)),
+      hop(0),
+      topology(nullptr),
       callback(callback),
-      callback_arg(callback_arg) {
+      callback_arg(callback_arg),
+      train_next(nullptr),
+      train_tail(this),
+      train_length(1),
+      ready_time(0) {
     assert(chunk_size > 0);
-    assert(!this->route.empty());
+    assert(this->route != nullptr);
+    assert(!this->route->empty());
     assert(callback != nullptr);
 }
 
-std::shared_ptr<Device> Chunk::current_device() const noexcept {
-    // assert the route is not empty
-    assert(!route.empty());
+void Chunk::set_topology(const Topology* const topology) noexcept {
+    assert(topology != nullptr);
+
+    this->topology = topology;
+}
+
+const Topology* Chunk::get_topology() const noexcept {
+    assert(topology != nullptr);
 
-    // return the first npu in route
-    return route.front();
+    return topology;
 }
 
-std::shared_ptr<Device> Chunk::next_device() const noexcept {
+size_t Chunk::get_hop() const noexcept {
+    assert(hop < route->size());
+
+    return hop;
+}
+
+DeviceId Chunk::current_device_id() const noexcept {
+    assert(hop < route->size());
+
+    // return the device at the hop cursor
+    return (*route)[hop];
+}
+
+DeviceId Chunk::next_device_id() const noexcept {
     // assert the chunk has next dest
     assert(!arrived_dest());
 
     // return next dest
-    const auto next_dest = std::next(route.begin(), 1);
-    return *next_dest;
+    return (*route)[hop + 1];
+}
+
+Device* Chunk::current_device() const noexcept {
+    assert(topology != nullptr);
+
+    // resolve the current device through the topology
+    return topology->get_device(current_device_id());
+}
+
+Device* Chunk::next_device() const noexcept {
+    assert(topology != nullptr);
+
+    // resolve the next device through the topology
+    return topology->get_device(next_device_id());
 }
 
 void Chunk::mark_arrived_next_device() noexcept {
@@ -63,15 +121,20 @@ void Chunk::mark_arrived_next_device() noexcept {
     // it means the chunk hasn't arrived its final dest yet
     assert(!arrived_dest());
 
-    // pop previous node from the route
+    // advance the hop cursor
     // marking the current node has been changed
-    route.pop_front();
+    hop++;
+
+    // the train travels as a whole
+    for (auto* chunk = train_next.get(); chunk != nullptr; chunk = chunk->train_next.get()) {
+        chunk->hop++;
+    }
 }
 
 bool Chunk::arrived_dest() const noexcept {
-    // if a chunk arrived dest, route length should be 1
-    // i.e., only containing the dest node
-    return route.size() == 1;
+    // if a chunk arrived dest, the hop cursor points to the last device
+    // i.e., only the dest node is left
+    return hop + 1 == route->size();
 }
 
 ChunkSize Chunk::get_size() const noexcept {
@@ -81,6 +144,55 @@ ChunkSize Chunk::get_size() const noexcept {
     return chunk_size;
 }
 
+bool Chunk::can_join_train(const Chunk& chunk) const noexcept {
+    // chunks sharing a cached route are compared without walking the route
+    const auto same_route = route == chunk.route || *route == *chunk.route;
+    return chunk_size == chunk.chunk_size && hop == chunk.hop && same_route;
+}
+
+void Chunk::append_to_train(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(can_join_train(*chunk));
+
+    auto* const tail = chunk->train_tail;
+    train_length += chunk->train_length;
+    train_tail->train_next = std::move(chunk);
+    train_tail = tail;
+}
+
+std::unique_ptr<Chunk> Chunk::detach_train() noexcept {
+    if (train_next == nullptr) {
+        return nullptr;
+    }
+
+    // the next chunk leads the rest of the train
+    auto train = std::move(train_next);
+    train->train_tail = train_tail;
+    train->train_length = train_length - 1;
+    train_tail = this;
+    train_length = 1;
+
+    return train;
+}
+
+Chunk* Chunk::get_train_next() const noexcept {
+    return train_next.get();
+}
+
+size_t Chunk::get_train_length() const noexcept {
+    assert(train_length > 0);
+
+    return train_length;
+}
+
+EventTime Chunk::get_ready_time() const noexcept {
+    return ready_time;
+}
+
+void Chunk::set_ready_time(const EventTime ready_time) noexcept {
+    this->ready_time = ready_time;
+}
+
 void Chunk::invoke_callback() noexcept {
     // invoke callback
     (*callback)(callback_arg);
@@ -5,13 +5,37 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/FastPathTransfer.h"
 #include "congestion_aware/Link.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Device::Device(const DeviceId id) noexcept : device_id(id) {
+Device::Device(const DeviceId id, SimulationContext* const context) noexcept
+    : device_id(id),
+      context(context),
+      link_dests(nullptr),
+      links(nullptr),
+      links_count(0),
+      implicit_dests_count(0),
+      implicit_bandwidth(0),
+      implicit_latency(0) {
     assert(id >= 0);
+    assert(context != nullptr);
+}
+
+void Device::set_context(SimulationContext* const context) noexcept {
+    assert(context != nullptr);
+
+    // move the device and its links
+    this->context = context;
+    for (auto i = size_t{0}; i < links_count; i++) {
+        links[i].set_context(context);
+    }
+    for (auto& [dest, link] : implicit_links) {
+        link.set_context(context);
+    }
 }
 
 DeviceId Device::get_id() const noexcept {
@@ -25,38 +49,109 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     // assert this node is the current source of the chunk
-    assert(chunk->current_device()->get_id() == device_id);
+    assert(chunk->current_device_id() == device_id);
 
     // assert the chunk hasn't arrived its final destination yet
     assert(!chunk->arrived_dest());
 
     // get next dest
-    const auto next_dest = chunk->next_device();
-    const auto next_dest_id = next_dest->get_id();
+    const auto next_dest_id = chunk->next_device_id();
 
-    // assert the next dest is connected to this node
-    assert(connected(next_dest_id));
+    // find the link to the next dest, which must be connected to this node
+    auto* const link = find_link(next_dest_id);
+    assert(link != nullptr);
+
+    // collapse the hops over idle links, unless chunks are delivered across event queues
+    if (context->get_link_model() == LinkModel::FastPath && !context->has_chunk_arrival_handler()) {
+        FastPathTransfer::send(std::move(chunk), link, context);
+        return;
+    }
 
     // send the chunk to the next dest
     // delegate this task to the link
-    links[next_dest_id]->send(std::move(chunk));
+    link->send(std::move(chunk));
 }
 
-void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency latency) noexcept {
-    assert(id >= 0);
+void Device::set_links(const DeviceId* const link_dests, Link* const links, const size_t links_count) noexcept {
+    assert(links_count == 0 || (link_dests != nullptr && links != nullptr));
+    assert(std::is_sorted(link_dests, link_dests + links_count));
+
+    this->link_dests = link_dests;
+    this->links = links;
+    this->links_count = links_count;
+}
+
+void Device::connect_all(const int devices_count, const Bandwidth bandwidth, const Latency latency) noexcept {
+    assert(devices_count > 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
 
-    // assert there's no existing connection
-    assert(!connected(id));
+    // assert there's no existing all-pairs connection
+    assert(implicit_dests_count == 0);
+
+    implicit_dests_count = devices_count;
+    implicit_bandwidth = bandwidth;
+    implicit_latency = latency;
+}
+
+size_t Device::get_materialized_links_count() const noexcept {
+    return implicit_links.size();
+}
+
+Latency Device::get_min_link_latency() const noexcept {
+    auto min_latency = Latency{-1};
+    for (auto i = size_t{0}; i < links_count; i++) {
+        const auto latency = links[i].get_latency();
+        if (min_latency < 0 || latency < min_latency) {
+            min_latency = latency;
+        }
+    }
+
+    // links connected by connect_all count whether materialized or not:
+    // they go to every device id in [0, implicit_dests_count) except the device's own
+    const auto implicit_peers_count = implicit_dests_count - (device_id < implicit_dests_count ? 1 : 0);
+    if (implicit_peers_count > 0 && (min_latency < 0 || implicit_latency < min_latency)) {
+        min_latency = implicit_latency;
+    }
+
+    return min_latency;
+}
 
-    // create link
-    links[id] = std::make_shared<Link>(bandwidth, latency);
+void Device::collect_link_telemetry(std::vector<LinkTelemetryEntry>& entries) const noexcept {
+    const auto first_entry = entries.size();
+
+    for (auto i = size_t{0}; i < links_count; i++) {
+        if (const auto* const telemetry = links[i].get_telemetry(); telemetry != nullptr) {
+            entries.push_back({device_id, link_dests[i], *telemetry});
+        }
+    }
+    for (const auto& [dest, link] : implicit_links) {
+        if (const auto* const telemetry = link.get_telemetry(); telemetry != nullptr) {
+            entries.push_back({device_id, dest, *telemetry});
+        }
+    }
+
+    // materialized links come in hash order
+    std::sort(entries.begin() + first_entry, entries.end(),
+              [](const LinkTelemetryEntry& a, const LinkTelemetryEntry& b) { return a.dest < b.dest; });
 }
 
-bool Device::connected(const DeviceId dest) const noexcept {
+Link* Device::find_link(const DeviceId dest) noexcept {
     assert(dest >= 0);
 
-    // check whether the connection exists
-    return links.find(dest) != links.end();
+    // binary search the destination among the sorted outgoing links
+    const auto* const end = link_dests + links_count;
+    const auto* const it = std::lower_bound(link_dests, end, dest);
+    if (it != end && *it == dest) {
+        return &links[it - link_dests];
+    }
+
+    // check whether connected by connect_all
+    if (dest >= implicit_dests_count || dest == device_id) {
+        return nullptr;
+    }
+
+    // materialize the link on first use
+    auto [entry, _] = implicit_links.try_emplace(dest, implicit_bandwidth, implicit_latency, context);
+    return &entry->second;
 }
@@ -0,0 +1,129 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/FastPathTransfer.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Topology.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+FastPathTransfer::FastPathTransfer(std::unique_ptr<Chunk> chunk, SimulationContext* const context) noexcept
+    : chunk(std::move(chunk)),
+      context(context) {
+    assert(this->chunk != nullptr);
+    assert(context != nullptr);
+}
+
+void FastPathTransfer::send(std::unique_ptr<Chunk> chunk, Link* const link, SimulationContext* const context) noexcept {
+    assert(chunk != nullptr);
+    assert(link != nullptr);
+    assert(context != nullptr);
+
+    // a busy first link queues the chunk as usual
+    const auto current_time = context->get_current_time();
+    if (!link->is_free_at(current_time)) {
+        link->send(std::move(chunk));
+        return;
+    }
+
+    // find the hops whose links are free by the time the chunk reaches them
+    const auto& route = chunk->get_route();
+    const auto* const topology = chunk->get_topology();
+    const auto chunk_size = chunk->get_size();
+    auto hop_links = std::vector<Link*>();
+    auto start_times = std::vector<EventTime>();
+    auto time = current_time;
+    auto* hop_link = link;
+    for (auto hop = chunk->get_hop();;) {
+        hop_links.push_back(hop_link);
+        start_times.push_back(time);
+        time += hop_link->communication_delay(chunk_size);
+
+        hop++;
+        if (hop + 1 == route.size()) {
+            break;
+        }
+        hop_link = topology->get_device(route[hop])->find_link(route[hop + 1]);
+        assert(hop_link != nullptr);
+        if (!hop_link->is_free_at(time)) {
+            break;
+        }
+    }
+
+    // a single hop has nothing to collapse
+    if (hop_links.size() < 2) {
+        link->send(std::move(chunk));
+        return;
+    }
+
+    // reserve every hop at once
+    auto* const transfer = new FastPathTransfer(std::move(chunk), context);
+    transfer->links = std::move(hop_links);
+    transfer->start_times = std::move(start_times);
+    for (auto hop = size_t{0}; hop < transfer->links.size(); hop++) {
+        transfer->links[hop]->reserve(transfer, hop, transfer->start_times[hop], chunk_size);
+    }
+
+    // schedule the arrival at the end of the collapsed hops
+    context->schedule_event(time, transfer_arrived, transfer);
+}
+
+void FastPathTransfer::revoke() noexcept {
+    assert(chunk != nullptr);
+
+    // the chunk already started the hops reached by now,
+    // and the first hop starts when the transfer is created
+    const auto current_time = context->get_current_time();
+    const auto first_hop_not_started = static_cast<size_t>(
+        std::upper_bound(start_times.begin(), start_times.end(), current_time) - start_times.begin());
+    assert(0 < first_hop_not_started && first_hop_not_started < links.size());
+
+    // cancel the reservations of the hops not started yet
+    for (auto hop = first_hop_not_started; hop < links.size(); hop++) {
+        links[hop]->release(this);
+    }
+
+    // the hops started by now took place as reserved
+    for (auto hop = size_t{0}; hop < first_hop_not_started; hop++) {
+        links[hop]->trace_hop(*chunk, chunk->get_hop() + hop, start_times[hop], start_times[hop]);
+    }
+
+    // the chunk reaches the first hop not started as in per-hop simulation
+    for (auto hop = size_t{1}; hop < first_hop_not_started; hop++) {
+        chunk->mark_arrived_next_device();
+    }
+    auto* const chunk_ptr = static_cast<void*>(chunk.release());
+    context->schedule_event(start_times[first_hop_not_started], Chunk::chunk_arrived_next_device, chunk_ptr);
+}
+
+void FastPathTransfer::transfer_arrived(void* const transfer_ptr) noexcept {
+    assert(transfer_ptr != nullptr);
+
+    // cast to unique_ptr<FastPathTransfer>
+    auto transfer = std::unique_ptr<FastPathTransfer>(static_cast<FastPathTransfer*>(transfer_ptr));
+
+    // a revoked transfer already handed its chunk over to per-hop simulation
+    if (transfer->chunk == nullptr) {
+        return;
+    }
+
+    // every reserved hop has started
+    for (auto hop = size_t{0}; hop < transfer->links.size(); hop++) {
+        auto* const link = transfer->links[hop];
+        link->commit_reservations();
+        link->trace_hop(*transfer->chunk, transfer->chunk->get_hop() + hop, transfer->start_times[hop],
+                        transfer->start_times[hop]);
+    }
+
+    // the chunk arrives at the device after the last collapsed hop
+    auto chunk = std::move(transfer->chunk);
+    for (auto hop = size_t{1}; hop < transfer->links.size(); hop++) {
+        chunk->mark_arrived_next_device();
+    }
+    Chunk::chunk_arrived_next_device(chunk.release());
+}
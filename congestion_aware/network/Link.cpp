@@ -5,41 +5,23 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Link.h"
 #include "common/NetworkFunction.h"
-#include "common/Flags.h"
+#include "common/Trace.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/FastPathTransfer.h"
+#include <algorithm>
 #include <cassert>
-#include <sstream>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-// declaring static event_queue
-std::shared_ptr<EventQueue> Link::event_queue;
-
-inline std::string route_to_string(const NetworkAnalyticalCongestionAware::Route& route) {
-    std::ostringstream oss;
-    oss << "[Link] Route: ";
-    bool first = true;
-    for (const auto& dev : route) {
-        if (!first) {
-            oss << " -> ";
-        }
-        first = false;
-        oss << (dev ? dev->get_id() : -1);
-    }
-    return oss.str();
-}
-
-
 void Link::link_become_free(void* const link_ptr) noexcept {
     assert(link_ptr != nullptr);
 
     // cast to Link*
     auto* const link = static_cast<Link*>(link_ptr);
 
-    debug_log("[Link] Link becomes free at time " +
-              std::to_string(Link::event_queue->get_current_time()));
+    ANALYTICAL_TRACE(Debug, LinkBecameFree, link->context->get_current_time(), link->pending_chunks.size());
 
     // set link free
     link->set_free();
@@ -50,30 +32,54 @@ void Link::link_become_free(void* const link_ptr) noexcept {
     }
 }
 
-void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
-    assert(event_queue_ptr != nullptr);
-
-    // set the event queue
-    Link::event_queue = std::move(event_queue_ptr);
-}
-
-Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
-    : bandwidth(bandwidth),
+Link::Link(const Bandwidth bandwidth, const Latency latency, SimulationContext* const context) noexcept
+    : context(context),
+      bandwidth(bandwidth),
       latency(latency),
       pending_chunks(),
-      busy(false) {
+      busy(false),
+      next_free_time(0),
+      telemetry(nullptr) {
     assert(bandwidth > 0);
     assert(latency >= 0);
+    assert(context != nullptr);
 
     // convert bandwidth from GB/s to B/ns
     bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
 }
 
+void Link::set_context(SimulationContext* const context) noexcept {
+    assert(context != nullptr);
+
+    this->context = context;
+}
+
 void Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
+    if (context->get_link_model() != LinkModel::EventDriven) {
+        // start time is computed arithmetically, no pending queue involved
+        reserve_chunk_transmission(std::move(chunk));
+        return;
+    }
+
+    // the chunk (or the train it leads) is ready to leave now
+    chunk->set_ready_time(context->get_current_time());
+
     if (busy) {
-        // link is busy, add to pending chunks
+        // link is busy, coalesce the chunk into the train waiting last if possible
+        if (!pending_chunks.empty()) {
+            auto& last_chunk = pending_chunks.back();
+            const auto train_length = last_chunk->get_train_length() + chunk->get_train_length();
+            if (train_length <= context->get_max_train_length() && last_chunk->can_join_train(*chunk)) {
+                record_queued_chunks(chunk->get_train_length());
+                last_chunk->append_to_train(std::move(chunk));
+                return;
+            }
+        }
+
+        // add to pending chunks
+        record_queued_chunks(chunk->get_train_length());
         pending_chunks.push_back(std::move(chunk));
     } else {
         // service this chunk immediately
@@ -88,6 +94,7 @@ void Link::process_pending_transmission() noexcept {
     // get chunk to process
     auto chunk = std::move(pending_chunks.front());
     pending_chunks.pop_front();
+    record_dequeued_chunks(chunk->get_train_length());
 
     // service this chunk
     schedule_chunk_transmission(std::move(chunk));
@@ -108,6 +115,50 @@ void Link::set_free() noexcept {
     busy = false;
 }
 
+Bandwidth Link::get_bandwidth() const noexcept {
+    assert(bandwidth > 0);
+
+    return bandwidth;
+}
+
+Latency Link::get_latency() const noexcept {
+    assert(latency >= 0);
+
+    return latency;
+}
+
+const LinkTelemetry* Link::get_telemetry() const noexcept {
+    return telemetry.get();
+}
+
+LinkTelemetry* Link::telemetry_to_record() noexcept {
+    if (!context->is_link_telemetry_enabled()) {
+        return nullptr;
+    }
+
+    // created lazily, so idle links cost nothing
+    if (telemetry == nullptr) {
+        telemetry = std::make_unique<LinkTelemetry>();
+    }
+    return telemetry.get();
+}
+
+void Link::record_queued_chunks(const size_t chunks_count) noexcept {
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        const auto queue_depth = link_telemetry->get_queue_depth() + chunks_count;
+        link_telemetry->record_queue_depth(context->get_current_time(), queue_depth);
+    }
+}
+
+void Link::record_dequeued_chunks(const size_t chunks_count) noexcept {
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        assert(link_telemetry->get_queue_depth() >= chunks_count);
+
+        const auto queue_depth = link_telemetry->get_queue_depth() - chunks_count;
+        link_telemetry->record_queue_depth(context->get_current_time(), queue_depth);
+    }
+}
+
 EventTime Link::serialization_delay(const ChunkSize chunk_size) const noexcept {
     assert(chunk_size > 0);
 
@@ -139,30 +190,173 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
 
     // get metadata
     const auto chunk_size = chunk->get_size();
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto current_time = context->get_current_time();
 
-    auto src_dev = chunk->current_device();
-    auto next_dev = chunk->next_device();
-
-    std::ostringstream oss;
-    oss << "[Link] Scheduling chunk transmission: "
-        << "ChunkPtr=" << chunk.get()
-        << ", ChunkSize=" << chunk_size
-        << ", From Device=" << (src_dev ? src_dev->get_id() : -1)
-        << ", To Device=" << (next_dev ? next_dev->get_id() : -1)
-        << ", Time=" << current_time;
-    debug_log(oss.str());
-    debug_log(route_to_string(chunk->get_route()));
+    ANALYTICAL_TRACE(Debug, ChunkTransmissionScheduled, current_time, chunk->current_device_id(),
+                     chunk->next_device_id(), chunk_size, chunk->get_hop());
 
     // schedule chunk arrival event
     const auto communication_time = communication_delay(chunk_size);
     const auto chunk_arrival_time = current_time + communication_time;
-    auto* const chunk_ptr = static_cast<void*>(chunk.release());
-    Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    const auto serialization_time = serialization_delay(chunk_size);
+    auto link_free_time = current_time + serialization_time;
+    if (chunk->get_train_next() == nullptr) {
+        if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+            link_telemetry->record_transmission(chunk->get_ready_time(), current_time, link_free_time, chunk_size);
+        }
+        trace_hop(*chunk, chunk->get_hop(), chunk->get_ready_time(), current_time);
+        context->deliver_chunk(current_time, chunk_arrival_time, std::move(chunk));
+    } else {
+        link_free_time = schedule_train_transmission(std::move(chunk));
+    }
 
     // schedule link free time
-    const auto serialization_time = serialization_delay(chunk_size);
-    const auto link_free_time = current_time + serialization_time;
     auto* const link_ptr = static_cast<void*>(this);
-    Link::event_queue->schedule_event(link_free_time, link_become_free, link_ptr);
-}
\ No newline at end of file
+    context->schedule_event(link_free_time, link_become_free, link_ptr);
+}
+
+EventTime Link::schedule_train_transmission(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // all chunks of a train share the same delays
+    const auto current_time = context->get_current_time();
+    const auto communication_time = communication_delay(chunk->get_size());
+    const auto serialization_time = serialization_delay(chunk->get_size());
+
+    // chunks start back to back, or once ready if they arrived spaced out
+    auto* const link_telemetry = telemetry_to_record();
+    auto link_free_time = current_time;
+    for (auto* train_chunk = chunk.get(); train_chunk != nullptr; train_chunk = train_chunk->get_train_next()) {
+        const auto start_time = std::max(train_chunk->get_ready_time(), link_free_time);
+        if (link_telemetry != nullptr) {
+            link_telemetry->record_transmission(train_chunk->get_ready_time(), start_time,
+                                                start_time + serialization_time, train_chunk->get_size());
+        }
+        trace_hop(*train_chunk, train_chunk->get_hop(), train_chunk->get_ready_time(), start_time);
+        train_chunk->set_ready_time(start_time + communication_time);
+        link_free_time = start_time + serialization_time;
+    }
+
+    // the train reaches an intermediate device as a whole, when its leader arrives
+    if (chunk->get_hop() + 2 < chunk->get_route().size()) {
+        const auto arrival_time = chunk->get_ready_time();
+        context->deliver_chunk(current_time, arrival_time, std::move(chunk));
+        return link_free_time;
+    }
+
+    // each chunk reaches the destination on its own, to invoke its callback in time
+    while (chunk != nullptr) {
+        auto train = chunk->detach_train();
+        const auto arrival_time = chunk->get_ready_time();
+        context->deliver_chunk(arrival_time - communication_time, arrival_time, std::move(chunk));
+        chunk = std::move(train);
+    }
+
+    return link_free_time;
+}
+
+void Link::reserve_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // get metadata
+    const auto chunk_size = chunk->get_size();
+    const auto current_time = context->get_current_time();
+
+    // a chunk reaching the link before transfers which reserved it ahead of time goes first,
+    // so these transfers fall back to per-hop simulation
+    commit_reservations();
+    while (!fast_path_reservations.empty()) {
+        fast_path_reservations.front().transfer->revoke();
+    }
+
+    // the chunk starts once every chunk reserved before it is serialized,
+    // which is when the event-driven model would pop it from the pending chunks
+    const auto start_time = std::max(current_time, next_free_time);
+    next_free_time = start_time + serialization_delay(chunk_size);
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        link_telemetry->record_transmission(current_time, start_time, next_free_time, chunk_size);
+    }
+    trace_hop(*chunk, chunk->get_hop(), current_time, start_time);
+
+    // schedule chunk arrival event
+    const auto chunk_arrival_time = start_time + communication_delay(chunk_size);
+    context->deliver_chunk(start_time, chunk_arrival_time, std::move(chunk));
+}
+
+void Link::trace_hop(const Chunk& chunk,
+                     const size_t hop,
+                     const EventTime ready_time,
+                     const EventTime start_time) const noexcept {
+    auto* const chrome_trace_writer = context->get_chrome_trace_writer().get();
+    if (chrome_trace_writer == nullptr) {
+        return;
+    }
+
+    const auto& route = chunk.get_route();
+    assert(hop + 1 < route.size());
+
+    const auto chunk_size = chunk.get_size();
+    chrome_trace_writer->record({route[hop], route[hop + 1], route.front(), route.back(), chunk_size, ready_time,
+                                 start_time, start_time + serialization_delay(chunk_size),
+                                 start_time + communication_delay(chunk_size)});
+}
+
+bool Link::is_free_at(const EventTime time) noexcept {
+    assert(time >= context->get_current_time());
+
+    commit_reservations();
+    return reserved_free_time() <= time;
+}
+
+EventTime Link::reserve(FastPathTransfer* const transfer,
+                        const size_t hop,
+                        const EventTime start_time,
+                        const ChunkSize chunk_size) noexcept {
+    assert(transfer != nullptr);
+    assert(reserved_free_time() <= start_time);
+
+    // reserve the link from the time the chunk reaches it
+    const auto end_time = start_time + serialization_delay(chunk_size);
+    fast_path_reservations.push_back({transfer, hop, start_time, end_time, chunk_size});
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        // the link is free when the chunk reaches it
+        link_telemetry->record_transmission(start_time, start_time, end_time, chunk_size);
+    }
+
+    return start_time + communication_delay(chunk_size);
+}
+
+void Link::release(const FastPathTransfer* const transfer) noexcept {
+    assert(transfer != nullptr);
+
+    const auto it = std::find_if(fast_path_reservations.begin(), fast_path_reservations.end(),
+                                 [transfer](const FastPathReservation& reservation) {
+                                     return reservation.transfer == transfer;
+                                 });
+    if (it != fast_path_reservations.end()) {
+        if (telemetry != nullptr) {
+            telemetry->cancel_transmission(it->start_time, it->start_time, it->end_time, it->chunk_size);
+        }
+        fast_path_reservations.erase(it);
+    }
+}
+
+void Link::commit_reservations() noexcept {
+    const auto current_time = context->get_current_time();
+
+    // transfers which reached the link hold it as a regular reservation
+    auto committed = fast_path_reservations.begin();
+    while (committed != fast_path_reservations.end() && committed->start_time <= current_time) {
+        next_free_time = std::max(next_free_time, committed->end_time);
+        committed++;
+    }
+    fast_path_reservations.erase(fast_path_reservations.begin(), committed);
+}
+
+EventTime Link::reserved_free_time() const noexcept {
+    if (fast_path_reservations.empty()) {
+        return next_free_time;
+    }
+
+    return std::max(next_free_time, fast_path_reservations.back().end_time);
+}
@@ -0,0 +1,337 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/CollectiveEngine.h"
+#include "common/NetworkFunction.h"
+#include "congestion_aware/Chunk.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// chunk sent from src NPU to dest NPU at a step of an algorithm
+using Transfer = std::tuple<DeviceId, DeviceId, ChunkSize>;
+
+/// NPUs exchanging data with each other in a phase of an algorithm
+using Group = std::vector<DeviceId>;
+
+/**
+ * Check if a number is a power of two.
+ *
+ * @param number number to check
+ * @return true if the number is a power of two, false otherwise
+ */
+bool is_power_of_two(const size_t number) noexcept {
+    return number > 0 && (number & (number - 1)) == 0;
+}
+
+}  // namespace
+
+CollectiveEngine::CollectiveEngine(std::shared_ptr<Topology> topology) noexcept
+    : topology(std::move(topology)),
+      injection_scheduled(false) {
+    assert(this->topology != nullptr);
+}
+
+CollectiveId CollectiveEngine::run(const CollectiveType type,
+                                   const CollectiveAlgorithm algorithm,
+                                   const ChunkSize size,
+                                   const Callback callback,
+                                   const CallbackArg callback_arg) noexcept {
+    assert(size > 0);
+
+    const auto current_time = topology->get_context()->get_current_time();
+    auto collective = std::make_unique<Collective>();
+    collective->engine = this;
+    collective->start_time = current_time;
+    collective->finish_time = current_time;
+    collective->callback = callback;
+    collective->callback_arg = callback_arg;
+    build(*collective, type, algorithm, size);
+    collective->chunks_count = collective->sends.size();
+    collective->pending_chunks_count = collective->sends.size();
+
+    const auto collective_id = static_cast<CollectiveId>(collectives.size());
+    auto& started = *collectives.emplace_back(std::move(collective));
+
+    // a collective over a single NPU has nothing to send
+    if (started.chunks_count == 0) {
+        if (callback != nullptr) {
+            callback(callback_arg);
+        }
+        return collective_id;
+    }
+
+    // the sends of the first step don't wait for any chunk
+    auto& root = started.barriers.front();
+    assert(root.pending_arrivals_count == 0);
+    for (const auto send : root.sends) {
+        make_ready(&started.sends[send]);
+    }
+    root.sends.clear();
+
+    return collective_id;
+}
+
+bool CollectiveEngine::is_finished(const CollectiveId collective_id) const noexcept {
+    assert(0 <= collective_id && static_cast<size_t>(collective_id) < collectives.size());
+
+    return collectives[collective_id]->pending_chunks_count == 0;
+}
+
+EventTime CollectiveEngine::get_start_time(const CollectiveId collective_id) const noexcept {
+    assert(0 <= collective_id && static_cast<size_t>(collective_id) < collectives.size());
+
+    return collectives[collective_id]->start_time;
+}
+
+EventTime CollectiveEngine::get_finish_time(const CollectiveId collective_id) const noexcept {
+    assert(is_finished(collective_id));
+
+    return collectives[collective_id]->finish_time;
+}
+
+size_t CollectiveEngine::get_chunks_count(const CollectiveId collective_id) const noexcept {
+    assert(0 <= collective_id && static_cast<size_t>(collective_id) < collectives.size());
+
+    return collectives[collective_id]->chunks_count;
+}
+
+void CollectiveEngine::build(Collective& collective,
+                             const CollectiveType type,
+                             const CollectiveAlgorithm algorithm,
+                             const ChunkSize size) const noexcept {
+    const auto npus_count = topology->get_npus_count();
+
+    // barrier 0 is the root of the DAG, released when the collective starts
+    collective.barriers.push_back({0, {}});
+    auto current_barriers = std::vector<int>(npus_count, 0);
+    auto step_barriers = std::vector<int>(npus_count, -1);
+
+    // sends of an NPU wait for the chunks it received at its previous step
+    const auto add_step = [&](const std::vector<Transfer>& transfers) {
+        std::fill(step_barriers.begin(), step_barriers.end(), -1);
+        for (const auto& [src, dest, chunk_size] : transfers) {
+            if (step_barriers[dest] < 0) {
+                step_barriers[dest] = static_cast<int>(collective.barriers.size());
+                collective.barriers.push_back({0, {}});
+            }
+            collective.barriers[current_barriers[src]].sends.push_back(collective.sends.size());
+            collective.barriers[step_barriers[dest]].pending_arrivals_count++;
+            collective.sends.push_back({&collective, src, dest, chunk_size, step_barriers[dest]});
+        }
+        for (auto npu = 0; npu < npus_count; npu++) {
+            if (step_barriers[npu] >= 0) {
+                current_barriers[npu] = step_barriers[npu];
+            }
+        }
+    };
+
+    // ring steps: at step s, every NPU sends a part of the buffer to the NPU offset(s) after it
+    const auto add_ring_steps = [&](const std::vector<Group>& groups, const ChunkSize data_size,
+                                    const bool all_to_all) {
+        const auto group_size = groups.front().size();
+        for (auto step = size_t{1}; step < group_size; step++) {
+            const auto offset = all_to_all ? step : 1;
+            auto transfers = std::vector<Transfer>();
+            for (const auto& group : groups) {
+                for (auto i = size_t{0}; i < group_size; i++) {
+                    transfers.emplace_back(group[i], group[(i + offset) % group_size],
+                                           part_size(data_size, group_size));
+                }
+            }
+            add_step(transfers);
+        }
+    };
+
+    // direct step: every NPU sends a part of the buffer to every other NPU
+    const auto add_direct_step = [&](const std::vector<Group>& groups, const ChunkSize data_size) {
+        auto transfers = std::vector<Transfer>();
+        for (const auto& group : groups) {
+            const auto group_size = group.size();
+            for (auto i = size_t{0}; i < group_size; i++) {
+                for (auto j = size_t{0}; j < group_size; j++) {
+                    if (i != j) {
+                        transfers.emplace_back(group[i], group[j], part_size(data_size, group_size));
+                    }
+                }
+            }
+        }
+        if (!transfers.empty()) {
+            add_step(transfers);
+        }
+    };
+
+    // halving-doubling steps: at each step, NPUs exchange with the NPU whose index differs by distance
+    const auto add_halving_doubling_steps = [&](const Group& group, const ChunkSize data_size,
+                                                const CollectiveType phase) {
+        const auto group_size = group.size();
+        for (auto distance = size_t{1}; distance < group_size; distance <<= 1) {
+            auto transfers = std::vector<Transfer>();
+            for (auto i = size_t{0}; i < group_size; i++) {
+                switch (phase) {
+                case CollectiveType::ReduceScatter:
+                    // halving: the farthest partner first, exchanging half of what's left
+                    transfers.emplace_back(group[i], group[i ^ (group_size / 2 / distance)],
+                                           part_size(data_size, 2 * distance));
+                    break;
+                case CollectiveType::AllGather:
+                    // doubling: the nearest partner first, exchanging all gathered so far
+                    transfers.emplace_back(group[i], group[i ^ distance],
+                                           part_size(data_size, group_size / distance));
+                    break;
+                default:
+                    // all-to-all: half of the buffer is forwarded towards its destination at each step
+                    transfers.emplace_back(group[i], group[i ^ distance], part_size(data_size, 2));
+                    break;
+                }
+            }
+            add_step(transfers);
+        }
+    };
+
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring:
+    case CollectiveAlgorithm::Direct:
+    case CollectiveAlgorithm::HalvingDoubling: {
+        auto group = Group(npus_count);
+        for (auto npu = 0; npu < npus_count; npu++) {
+            group[npu] = npu;
+        }
+
+        if (algorithm == CollectiveAlgorithm::HalvingDoubling && !is_power_of_two(group.size())) {
+            std::cerr << "[Error] (network/analytical/congestion_aware) "
+                      << "halving-doubling requires a power-of-two number of NPUs, got " << npus_count
+                      << std::endl;
+            std::exit(-1);
+        }
+
+        const auto add_phase = [&](const CollectiveType phase) {
+            const auto groups = std::vector<Group>{group};
+            switch (algorithm) {
+            case CollectiveAlgorithm::Ring:
+                add_ring_steps(groups, size, phase == CollectiveType::AllToAll);
+                break;
+            case CollectiveAlgorithm::Direct:
+                add_direct_step(groups, size);
+                break;
+            default:
+                add_halving_doubling_steps(group, size, phase);
+                break;
+            }
+        };
+
+        if (type == CollectiveType::AllReduce) {
+            add_phase(CollectiveType::ReduceScatter);
+            add_phase(CollectiveType::AllGather);
+        } else {
+            add_phase(type);
+        }
+        break;
+    }
+    case CollectiveAlgorithm::Hierarchical: {
+        // NPUs of dimension k which differ only in their k-th coordinate form a group
+        const auto npus_count_per_dim = topology->get_npus_count_per_dim();
+        const auto dims_count = static_cast<int>(npus_count_per_dim.size());
+        auto groups_per_dim = std::vector<std::vector<Group>>(dims_count);
+        auto stride = 1;
+        for (auto dim = 0; dim < dims_count; dim++) {
+            const auto dim_size = npus_count_per_dim[dim];
+            for (auto npu = 0; npu < npus_count; npu++) {
+                if ((npu / stride) % dim_size != 0) {
+                    continue;
+                }
+                auto group = Group(dim_size);
+                for (auto i = 0; i < dim_size; i++) {
+                    group[i] = npu + i * stride;
+                }
+                groups_per_dim[dim].push_back(std::move(group));
+            }
+            stride *= dim_size;
+        }
+        assert(stride == npus_count);
+
+        for (const auto& phase : hierarchical_phases(type, npus_count_per_dim, size)) {
+            if (phase.algorithm == CollectiveAlgorithm::Direct) {
+                add_direct_step(groups_per_dim[phase.dim], phase.data_size);
+            } else {
+                add_ring_steps(groups_per_dim[phase.dim], phase.data_size, false);
+            }
+        }
+        break;
+    }
+    }
+}
+
+void CollectiveEngine::make_ready(Send* const send) noexcept {
+    assert(send != nullptr);
+
+    ready_sends.push_back(send);
+
+    // sends becoming ready at the same time are injected together
+    if (!injection_scheduled) {
+        injection_scheduled = true;
+        const auto context = topology->get_context();
+        context->schedule_event(context->get_current_time(), inject_ready_sends, this);
+    }
+}
+
+void CollectiveEngine::inject_ready_sends(void* const engine_ptr) noexcept {
+    assert(engine_ptr != nullptr);
+
+    // cast to CollectiveEngine*
+    auto* const engine = static_cast<CollectiveEngine*>(engine_ptr);
+    auto sends = std::move(engine->ready_sends);
+    engine->ready_sends.clear();
+    engine->injection_scheduled = false;
+
+    for (auto* const send : sends) {
+        const auto route = engine->topology->cached_route(send->src, send->dest);
+        auto chunk = std::make_unique<Chunk>(send->size, route, chunk_arrived, send);
+        engine->topology->send(std::move(chunk));
+    }
+}
+
+void CollectiveEngine::chunk_arrived(void* const send_ptr) noexcept {
+    assert(send_ptr != nullptr);
+
+    // cast to Send*
+    const auto* const send = static_cast<Send*>(send_ptr);
+    auto* const collective = send->collective;
+    auto* const engine = collective->engine;
+    assert(collective->pending_chunks_count > 0);
+
+    // release the sends waiting for the chunks received at this step
+    if (send->barrier >= 0) {
+        auto& barrier = collective->barriers[send->barrier];
+        assert(barrier.pending_arrivals_count > 0);
+        barrier.pending_arrivals_count--;
+        if (barrier.pending_arrivals_count == 0) {
+            for (const auto waiting_send : barrier.sends) {
+                engine->make_ready(&collective->sends[waiting_send]);
+            }
+            barrier.sends.clear();
+        }
+    }
+
+    collective->pending_chunks_count--;
+    if (collective->pending_chunks_count > 0) {
+        return;
+    }
+
+    // the collective finished, its DAG is no longer needed
+    collective->finish_time = engine->topology->get_context()->get_current_time();
+    collective->sends = {};
+    collective->barriers = {};
+    if (collective->callback != nullptr) {
+        collective->callback(collective->callback_arg);
+    }
+}
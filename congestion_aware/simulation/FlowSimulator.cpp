@@ -0,0 +1,229 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/FlowSimulator.h"
+#include "common/NetworkFunction.h"
+#include "congestion_aware/Device.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// bytes below which a flow counts as drained, absorbing floating-point error
+constexpr auto drained_bytes = 1e-3;
+
+/// relative tolerance when comparing fair shares of links
+constexpr auto fair_share_tolerance = 1e-9;
+
+}  // namespace
+
+FlowSimulator::FlowSimulator(std::shared_ptr<Topology> topology) noexcept
+    : topology(std::move(topology)),
+      last_update_time(0),
+      next_update_time(std::numeric_limits<EventTime>::max()),
+      rate_updates_count(0) {
+    assert(this->topology != nullptr);
+}
+
+void FlowSimulator::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // device ids of the route are resolved by the topology
+    chunk->set_topology(topology.get());
+
+    // flows sent at the same time are admitted together, so rates are recomputed once
+    new_chunks.push_back(std::move(chunk));
+    schedule_update(topology->get_context()->get_current_time());
+}
+
+size_t FlowSimulator::get_active_flows_count() const noexcept {
+    return flows.size();
+}
+
+uint64_t FlowSimulator::get_rate_updates_count() const noexcept {
+    return rate_updates_count;
+}
+
+void FlowSimulator::update(void* const simulator_ptr) noexcept {
+    assert(simulator_ptr != nullptr);
+
+    // cast to FlowSimulator*
+    auto* const simulator = static_cast<FlowSimulator*>(simulator_ptr);
+    simulator->update();
+}
+
+void FlowSimulator::flow_arrived_dest(void* const chunk_ptr) noexcept {
+    assert(chunk_ptr != nullptr);
+
+    // cast to unique_ptr<Chunk>, destroyed once the callback returns
+    auto chunk = std::unique_ptr<Chunk>(static_cast<Chunk*>(chunk_ptr));
+    chunk->invoke_callback();
+}
+
+void FlowSimulator::update() noexcept {
+    const auto context = topology->get_context();
+    const auto current_time = context->get_current_time();
+    assert(current_time >= last_update_time);
+
+    // the update scheduled for now is being processed
+    if (next_update_time <= current_time) {
+        next_update_time = std::numeric_limits<EventTime>::max();
+    }
+
+    // drain flows at their rates since the last update
+    const auto elapsed_time = static_cast<double>(current_time - last_update_time);
+    for (auto& flow : flows) {
+        flow.remaining_bytes -= flow.rate * elapsed_time;
+    }
+    last_update_time = current_time;
+
+    // retire drained flows, which reach their destination after the latency of their route
+    const auto flows_count = flows.size();
+    for (auto i = size_t{0}; i < flows.size();) {
+        auto& flow = flows[i];
+        if (flow.remaining_bytes > drained_bytes) {
+            i++;
+            continue;
+        }
+
+        context->schedule_event(current_time + flow.latency, flow_arrived_dest, flow.chunk.release());
+        if (i + 1 < flows.size()) {
+            flow = std::move(flows.back());
+        }
+        flows.pop_back();
+    }
+    auto flows_changed = flows.size() != flows_count;
+
+    // admit flows sent since the last update
+    auto chunks = std::move(new_chunks);
+    new_chunks.clear();
+    for (auto& chunk : chunks) {
+        admit(std::move(chunk));
+        flows_changed = true;
+    }
+
+    if (flows.empty()) {
+        return;
+    }
+
+    // rates only change when flows start or finish
+    if (flows_changed) {
+        update_rates();
+    }
+
+    // schedule an update when the next flow is drained
+    auto next_drain_time = std::numeric_limits<EventTime>::max();
+    for (const auto& flow : flows) {
+        assert(flow.rate > 0);
+        const auto drain_time = static_cast<EventTime>(std::ceil(flow.remaining_bytes / flow.rate));
+        next_drain_time = std::min(next_drain_time, current_time + std::max(drain_time, EventTime{1}));
+    }
+    schedule_update(next_drain_time);
+}
+
+void FlowSimulator::admit(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    auto flow = Flow{nullptr, {}, static_cast<double>(chunk->get_size()), -1, 0};
+
+    // resolve the links of the route
+    const auto& route = chunk->get_route();
+    auto latency = Latency{0};
+    flow.links.reserve(route.size() - 1);
+    for (auto hop = size_t{1}; hop < route.size(); hop++) {
+        const auto* const link = topology->get_device(route[hop - 1])->find_link(route[hop]);
+        assert(link != nullptr);
+        latency += link->get_latency();
+
+        // index the link on first use
+        const auto [it, inserted] = link_indices.try_emplace(link, link_states.size());
+        if (inserted) {
+            link_states.push_back({bw_GBps_to_Bpns(link->get_bandwidth()), 0, 0});
+        }
+        flow.links.push_back(it->second);
+    }
+    flow.latency = static_cast<EventTime>(latency);
+    flow.chunk = std::move(chunk);
+
+    // a chunk sent to its own source crosses no link
+    if (flow.links.empty()) {
+        const auto context = topology->get_context();
+        context->schedule_event(context->get_current_time(), flow_arrived_dest, flow.chunk.release());
+        return;
+    }
+
+    flows.push_back(std::move(flow));
+}
+
+void FlowSimulator::update_rates() noexcept {
+    rate_updates_count++;
+
+    // every flow starts unfrozen, with the whole capacity of links available
+    for (auto& link_state : link_states) {
+        link_state.residual_capacity = link_state.capacity;
+        link_state.unfrozen_flows_count = 0;
+    }
+    for (auto& flow : flows) {
+        flow.rate = -1;
+        for (const auto link : flow.links) {
+            link_states[link].unfrozen_flows_count++;
+        }
+    }
+
+    auto unfrozen_flows_count = flows.size();
+    auto bottlenecks = std::vector<bool>(link_states.size());
+    while (unfrozen_flows_count > 0) {
+        // find the smallest fair share offered by a link
+        auto fair_share = std::numeric_limits<double>::max();
+        for (const auto& link_state : link_states) {
+            if (link_state.unfrozen_flows_count > 0) {
+                fair_share = std::min(fair_share, link_state.residual_capacity / link_state.unfrozen_flows_count);
+            }
+        }
+
+        // links offering that share are the bottlenecks of this round
+        for (auto i = size_t{0}; i < link_states.size(); i++) {
+            const auto& link_state = link_states[i];
+            bottlenecks[i] = link_state.unfrozen_flows_count > 0 &&
+                             link_state.residual_capacity / link_state.unfrozen_flows_count <=
+                                 fair_share * (1 + fair_share_tolerance);
+        }
+
+        // freeze the flows crossing a bottleneck at the fair share
+        for (auto& flow : flows) {
+            if (flow.rate >= 0) {
+                continue;
+            }
+            const auto bottlenecked = std::any_of(flow.links.begin(), flow.links.end(),
+                                                  [&](const size_t link) { return bottlenecks[link]; });
+            if (!bottlenecked) {
+                continue;
+            }
+
+            flow.rate = fair_share;
+            unfrozen_flows_count--;
+            for (const auto link : flow.links) {
+                auto& link_state = link_states[link];
+                link_state.residual_capacity = std::max(link_state.residual_capacity - fair_share, 0.0);
+                link_state.unfrozen_flows_count--;
+            }
+        }
+    }
+}
+
+void FlowSimulator::schedule_update(const EventTime event_time) noexcept {
+    // an earlier update reschedules the following one itself
+    if (next_update_time <= event_time) {
+        return;
+    }
+
+    next_update_time = event_time;
+    topology->get_context()->schedule_event(event_time, update, this);
+}
@@ -0,0 +1,263 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ParallelSimulator.h"
+#include "congestion_aware/Device.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+// declaring static thread-local binding
+thread_local ParallelSimulator::Partition* ParallelSimulator::current_partition = nullptr;
+
+EventTime ParallelSimulator::current_time() noexcept {
+    assert(current_partition != nullptr);
+
+    return current_partition->event_queue->get_current_time();
+}
+
+ParallelSimulator::ParallelSimulator(std::shared_ptr<Topology> topology, const int threads_count) noexcept
+    : topology(std::move(topology)),
+      lookahead(0),
+      window_end(0),
+      done(false) {
+    assert(this->topology != nullptr);
+    assert(threads_count > 0);
+
+    const auto devices_count = this->topology->get_devices_count();
+    const auto min_latency = this->topology->get_min_link_latency();
+
+    // every transmission takes at least the minimum link latency
+    // zero lookahead leaves no room for parallelism: run a single partition sequentially
+    auto partitions_count = std::min(threads_count, devices_count);
+    if (min_latency >= 1) {
+        lookahead = static_cast<EventTime>(std::floor(min_latency));
+    } else {
+        partitions_count = 1;
+    }
+
+    // create partitions
+    partitions = std::vector<Partition>(partitions_count);
+    for (auto i = 0; i < partitions_count; i++) {
+        auto& partition = partitions[i];
+        partition.index = i;
+        partition.event_queue = std::make_shared<EventQueue>();
+        partition.context = std::make_shared<SimulationContext>(partition.event_queue);
+        partition.context->set_link_model(this->topology->get_context()->get_link_model());
+        partition.context->set_max_train_length(this->topology->get_context()->get_max_train_length());
+        partition.context->set_link_telemetry_enabled(this->topology->get_context()->is_link_telemetry_enabled());
+        partition.context->set_chrome_trace_writer(this->topology->get_context()->get_chrome_trace_writer());
+        if (lookahead > 0) {
+            // chunk arrivals are exchanged at window boundaries
+            partition.context->set_chunk_arrival_handler(post_chunk, this);
+        }
+        partition.outboxes = std::vector<std::vector<Message>>(partitions_count);
+        partition.next_event_time = 0;
+    }
+
+    sends_count = std::vector<uint64_t>(devices_count, 0);
+
+    // move each device to the context of its partition
+    for (auto i = 0; i < devices_count; i++) {
+        this->topology->set_device_context(i, partitions[partition_of(i)].context.get());
+    }
+}
+
+ParallelSimulator::~ParallelSimulator() noexcept {
+    // move the devices back to the context of the topology
+    const auto context = topology->get_context();
+    for (auto i = 0; i < topology->get_devices_count(); i++) {
+        topology->set_device_context(i, context.get());
+    }
+}
+
+void ParallelSimulator::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // the source device schedules the transmission in the context of its partition
+    topology->send(std::move(chunk));
+}
+
+void ParallelSimulator::run() noexcept {
+    if (lookahead == 0) {
+        // sequential fallback: chunk arrivals are scheduled directly by links
+        auto& partition = partitions[0];
+        current_partition = &partition;
+        while (!partition.event_queue->finished()) {
+            partition.event_queue->proceed();
+        }
+        current_partition = nullptr;
+        return;
+    }
+
+    // the calling thread drives partition 0, and a worker thread is spawned for each other partition
+    auto barrier = Barrier(static_cast<int>(partitions.size()));
+    auto workers = std::vector<std::thread>();
+    for (auto i = size_t{1}; i < partitions.size(); i++) {
+        workers.emplace_back([this, i, &barrier]() { run_partition(partitions[i], barrier); });
+    }
+    run_partition(partitions[0], barrier);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+EventTime ParallelSimulator::get_current_time() const noexcept {
+    auto current_time = EventTime{0};
+    for (const auto& partition : partitions) {
+        current_time = std::max(current_time, partition.event_queue->get_current_time());
+    }
+
+    return current_time;
+}
+
+int ParallelSimulator::get_partitions_count() const noexcept {
+    return static_cast<int>(partitions.size());
+}
+
+EventTime ParallelSimulator::get_lookahead() const noexcept {
+    return lookahead;
+}
+
+int ParallelSimulator::partition_of(const DeviceId device_id) const noexcept {
+    const auto devices_count = static_cast<int64_t>(sends_count.size());
+    assert(0 <= device_id && device_id < devices_count);
+
+    // contiguous blocks of device ids
+    return static_cast<int>(static_cast<int64_t>(device_id) * static_cast<int64_t>(partitions.size()) / devices_count);
+}
+
+void ParallelSimulator::post_chunk(void* const simulator_ptr,
+                                   const EventTime send_time,
+                                   const EventTime arrival_time,
+                                   std::unique_ptr<Chunk> chunk) noexcept {
+    assert(simulator_ptr != nullptr);
+    assert(chunk != nullptr);
+
+    auto* const simulator = static_cast<ParallelSimulator*>(simulator_ptr);
+    const auto source_id = chunk->current_device_id();
+    const auto dest_id = chunk->next_device_id();
+
+    // links are driven by the thread of their source device's partition
+    auto& source = simulator->partitions[simulator->partition_of(source_id)];
+    assert(current_partition == nullptr || current_partition == &source);
+
+    // the arrival must fall beyond the current window
+    assert(arrival_time >= send_time + simulator->lookahead);
+
+    // buffer the chunk until the window boundary
+    const auto sequence = simulator->sends_count[source_id]++;
+    auto& outbox = source.outboxes[simulator->partition_of(dest_id)];
+    outbox.push_back({arrival_time, send_time, source_id, sequence, chunk.release()});
+}
+
+void ParallelSimulator::advance_window(ParallelSimulator* const simulator) noexcept {
+    assert(simulator != nullptr);
+
+    // the window starts at the earliest pending event over all partitions
+    auto window_start = std::numeric_limits<EventTime>::max();
+    for (const auto& partition : simulator->partitions) {
+        window_start = std::min(window_start, partition.next_event_time);
+    }
+
+    if (window_start == std::numeric_limits<EventTime>::max()) {
+        // no event left anywhere
+        simulator->done = true;
+        return;
+    }
+
+    simulator->window_end = window_start + simulator->lookahead;
+}
+
+void ParallelSimulator::deliver(Partition& partition) noexcept {
+    // gather the messages sent to this partition
+    auto& inbox = partition.inbox;
+    inbox.clear();
+    for (auto& source : partitions) {
+        auto& outbox = source.outboxes[partition.index];
+        inbox.insert(inbox.end(), outbox.begin(), outbox.end());
+        outbox.clear();
+    }
+
+    // order the messages independently of the partitioning
+    std::sort(inbox.begin(), inbox.end(), [](const Message& lhs, const Message& rhs) {
+        if (lhs.arrival_time != rhs.arrival_time) {
+            return lhs.arrival_time < rhs.arrival_time;
+        }
+        if (lhs.send_time != rhs.send_time) {
+            return lhs.send_time < rhs.send_time;
+        }
+        if (lhs.source_id != rhs.source_id) {
+            return lhs.source_id < rhs.source_id;
+        }
+        return lhs.sequence < rhs.sequence;
+    });
+
+    // schedule the arrivals
+    for (const auto& message : inbox) {
+        auto* const chunk_ptr = static_cast<void*>(message.chunk);
+        partition.event_queue->schedule_event(message.arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    }
+}
+
+void ParallelSimulator::run_partition(Partition& partition, Barrier& barrier) noexcept {
+    current_partition = &partition;
+    auto& event_queue = partition.event_queue;
+
+    while (true) {
+        // receive the messages sent during the previous window
+        deliver(partition);
+        partition.next_event_time =
+            event_queue->finished() ? std::numeric_limits<EventTime>::max() : event_queue->get_next_event_time();
+
+        // agree on the next window
+        barrier.arrive_and_wait(advance_window, this);
+        if (done) {
+            break;
+        }
+
+        // process the window
+        while (!event_queue->finished() && event_queue->get_next_event_time() < window_end) {
+            event_queue->proceed();
+        }
+
+        // wait until every message of the window is posted
+        barrier.arrive_and_wait(nullptr, this);
+    }
+
+    current_partition = nullptr;
+}
+
+ParallelSimulator::Barrier::Barrier(const int threads_count) noexcept
+    : threads_count(threads_count),
+      arrived_count(0),
+      generation(0) {
+    assert(threads_count > 0);
+}
+
+void ParallelSimulator::Barrier::arrive_and_wait(void (*const completion)(ParallelSimulator*),
+                                                 ParallelSimulator* const simulator) noexcept {
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    const auto arrived_generation = generation;
+
+    arrived_count++;
+    if (arrived_count == threads_count) {
+        // last thread to arrive: complete the phase and release the others
+        if (completion != nullptr) {
+            (*completion)(simulator);
+        }
+        arrived_count = 0;
+        generation++;
+        released.notify_all();
+        return;
+    }
+
+    released.wait(lock, [this, arrived_generation]() { return generation != arrived_generation; });
+}
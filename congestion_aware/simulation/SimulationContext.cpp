@@ -0,0 +1,111 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Chunk.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+std::shared_ptr<SimulationContext> SimulationContext::default_context() noexcept {
+    static const auto context = std::make_shared<SimulationContext>();
+
+    return context;
+}
+
+SimulationContext::SimulationContext(std::shared_ptr<EventQueue> event_queue) noexcept
+    : event_queue(std::move(event_queue)),
+      link_model(LinkModel::EventDriven),
+      max_train_length(1),
+      link_telemetry_enabled(false),
+      chrome_trace_writer(nullptr),
+      chunk_arrival_handler(nullptr),
+      chunk_arrival_handler_arg(nullptr) {}
+
+void SimulationContext::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
+    assert(event_queue != nullptr);
+
+    this->event_queue = std::move(event_queue);
+}
+
+std::shared_ptr<EventQueue> SimulationContext::get_event_queue() const noexcept {
+    return event_queue;
+}
+
+EventTime SimulationContext::get_current_time() const noexcept {
+    assert(event_queue != nullptr);
+
+    return event_queue->get_current_time();
+}
+
+void SimulationContext::schedule_event(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg callback_arg) noexcept {
+    assert(event_queue != nullptr);
+    assert(callback != nullptr);
+
+    event_queue->schedule_event(event_time, callback, callback_arg);
+}
+
+void SimulationContext::set_link_model(const LinkModel link_model) noexcept {
+    this->link_model = link_model;
+}
+
+LinkModel SimulationContext::get_link_model() const noexcept {
+    return link_model;
+}
+
+void SimulationContext::set_chunk_arrival_handler(const ChunkArrivalHandler handler, void* const handler_arg) noexcept {
+    chunk_arrival_handler = handler;
+    chunk_arrival_handler_arg = handler_arg;
+}
+
+void SimulationContext::set_max_train_length(const size_t max_train_length) noexcept {
+    assert(max_train_length > 0);
+
+    this->max_train_length = max_train_length;
+}
+
+size_t SimulationContext::get_max_train_length() const noexcept {
+    return max_train_length;
+}
+
+void SimulationContext::set_link_telemetry_enabled(const bool enabled) noexcept {
+    link_telemetry_enabled = enabled;
+}
+
+bool SimulationContext::is_link_telemetry_enabled() const noexcept {
+    return link_telemetry_enabled;
+}
+
+void SimulationContext::set_chrome_trace_writer(std::shared_ptr<ChromeTraceWriter> chrome_trace_writer) noexcept {
+    this->chrome_trace_writer = std::move(chrome_trace_writer);
+}
+
+const std::shared_ptr<ChromeTraceWriter>& SimulationContext::get_chrome_trace_writer() const noexcept {
+    return chrome_trace_writer;
+}
+
+bool SimulationContext::has_chunk_arrival_handler() const noexcept {
+    return chunk_arrival_handler != nullptr;
+}
+
+void SimulationContext::deliver_chunk(const EventTime send_time,
+                                      const EventTime arrival_time,
+                                      std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(arrival_time >= send_time);
+
+    if (chunk_arrival_handler != nullptr) {
+        // delivery is taken over by the handler
+        (*chunk_arrival_handler)(chunk_arrival_handler_arg, send_time, arrival_time, std::move(chunk));
+        return;
+    }
+
+    // schedule the arrival of the chunk
+    auto* const chunk_ptr = static_cast<void*>(chunk.release());
+    schedule_event(arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+}
@@ -14,7 +14,8 @@ using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
 std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
-    const NetworkParser& network_parser) noexcept {
+    const NetworkParser& network_parser,
+    std::shared_ptr<SimulationContext> context) noexcept {
     // get network_parser info
     const auto dims_count = network_parser.get_dims_count();
     const auto topologies_per_dim = network_parser.get_topologies_per_dim();
@@ -34,16 +35,27 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
     const auto bandwidth = bandwidths_per_dim[0];
     const auto latency = latencies_per_dim[0];
 
+    auto topology = std::shared_ptr<Topology>();
     switch (topology_type) {
     case TopologyBuildingBlock::Ring:
-        return std::make_shared<Ring>(npus_count, bandwidth, latency);
+        topology = std::make_shared<Ring>(npus_count, bandwidth, latency);
+        break;
     case TopologyBuildingBlock::Switch:
-        return std::make_shared<Switch>(npus_count, bandwidth, latency);
+        topology = std::make_shared<Switch>(npus_count, bandwidth, latency);
+        break;
     case TopologyBuildingBlock::FullyConnected:
-        return std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
+        topology = std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
+        break;
     default:
         // shouldn't reaach here
         std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology" << std::endl;
         std::exit(-1);
     }
+
+    // run the topology in the given context
+    if (context != nullptr) {
+        topology->set_context(std::move(context));
+    }
+
+    return topology;
 }
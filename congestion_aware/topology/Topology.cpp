@@ -5,6 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Topology.h"
 #include "congestion_aware/Link.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
@@ -12,14 +13,42 @@ using namespace NetworkAnalyticalCongestionAware;
 void Topology::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
     assert(event_queue != nullptr);
 
-    // pass the given event_queue to Link
-    Link::set_event_queue(std::move(event_queue));
+    // topologies without their own context run in the default one
+    SimulationContext::default_context()->set_event_queue(std::move(event_queue));
 }
 
-Topology::Topology() noexcept : npus_count(-1), devices_count(-1), dims_count(-1) {
+Topology::Topology() noexcept
+    : context(SimulationContext::default_context()),
+      npus_count(-1),
+      devices_count(-1),
+      dims_count(-1) {
     npus_count_per_dim = {};
 }
 
+// default destructor
+Topology::~Topology() noexcept = default;
+
+void Topology::set_context(std::shared_ptr<SimulationContext> context) noexcept {
+    assert(context != nullptr);
+
+    // move every device, and their links
+    this->context = std::move(context);
+    for (const auto& device : devices) {
+        device->set_context(this->context.get());
+    }
+}
+
+std::shared_ptr<SimulationContext> Topology::get_context() const noexcept {
+    return context;
+}
+
+void Topology::set_device_context(const DeviceId device_id, SimulationContext* const context) noexcept {
+    assert(0 <= device_id && device_id < devices_count);
+    assert(context != nullptr);
+
+    devices[device_id]->set_context(context);
+}
+
 int Topology::get_devices_count() const noexcept {
     assert(devices_count > 0);
     assert(npus_count > 0);
@@ -54,15 +83,77 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
     return bandwidth_per_dim;
 }
 
+Latency Topology::get_min_link_latency() const noexcept {
+    auto min_latency = Latency{-1};
+    for (const auto& device : devices) {
+        const auto latency = device->get_min_link_latency();
+        if (latency >= 0 && (min_latency < 0 || latency < min_latency)) {
+            min_latency = latency;
+        }
+    }
+
+    return min_latency;
+}
+
+std::vector<LinkTelemetryEntry> Topology::get_link_telemetry() const noexcept {
+    auto entries = std::vector<LinkTelemetryEntry>();
+    for (const auto& device : devices) {
+        device->collect_link_telemetry(entries);
+    }
+
+    return entries;
+}
+
+std::shared_ptr<const Route> Topology::cached_route(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    if (npus_count <= max_npus_for_all_pairs_routes) {
+        // small topology: build the routes of all pairs at first use
+        std::call_once(all_pairs_routes_built, [this]() {
+            all_pairs_routes.reserve(npus_count * npus_count);
+            for (auto i = 0; i < npus_count; i++) {
+                for (auto j = 0; j < npus_count; j++) {
+                    all_pairs_routes.push_back(std::make_shared<const Route>(route(i, j)));
+                }
+            }
+        });
+
+        return all_pairs_routes[src * npus_count + dest];
+    }
+
+    // large topology: memoize the route of each requested pair
+    const auto key = (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dest);
+    const auto lock = std::lock_guard<std::mutex>(memoized_routes_mutex);
+    auto& memoized_route = memoized_routes[key];
+    if (memoized_route == nullptr) {
+        memoized_route = std::make_shared<const Route>(route(src, dest));
+    }
+
+    return memoized_route;
+}
+
+Device* Topology::get_device(const DeviceId device_id) const noexcept {
+    assert(0 <= device_id && device_id < devices_count);
+
+    return devices[device_id].get();
+}
+
 void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     // get src npu node_id
-    const auto src = chunk->current_device()->get_id();
+    const auto src = chunk->current_device_id();
 
     // assert src is valid
     assert(0 <= src && src < devices_count);
 
+    // links must have been built
+    assert(connections.empty());
+
+    // device ids of the route are resolved by this topology
+    chunk->set_topology(this);
+
     // initiate transmission from src
     devices[src]->send(std::move(chunk));
 }
@@ -80,18 +171,73 @@ void Topology::connect(const DeviceId src,
     assert(bandwidth > 0);
     assert(latency >= 0);
 
+    // links can't be added once built
+    assert(links.empty());
+
     // connect src -> dest
-    devices[src]->connect(dest, bandwidth, latency);
+    connections.push_back({src, dest, bandwidth, latency});
 
     // if bidirectional, connect dest -> src
     if (bidirectional) {
-        devices[dest]->connect(src, bandwidth, latency);
+        connections.push_back({dest, src, bandwidth, latency});
     }
 }
 
+void Topology::connect_all_pairs(const Bandwidth bandwidth, const Latency latency) noexcept {
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    // links can't be added once built
+    assert(links.empty());
+
+    // every device lazily connects to every other device
+    for (const auto& device : devices) {
+        device->connect_all(devices_count, bandwidth, latency);
+    }
+}
+
+void Topology::build_links() noexcept {
+    assert(links.empty());
+    assert(static_cast<int>(devices.size()) == devices_count);
+
+    // group connections by src, then order them by dest
+    std::sort(connections.begin(), connections.end(), [](const Connection& lhs, const Connection& rhs) {
+        return lhs.src != rhs.src ? lhs.src < rhs.src : lhs.dest < rhs.dest;
+    });
+
+    // count the outgoing links of each device, then accumulate them into offsets
+    link_offsets.assign(devices_count + 1, 0);
+    for (const auto& connection : connections) {
+        link_offsets[connection.src + 1]++;
+    }
+    for (auto i = 0; i < devices_count; i++) {
+        link_offsets[i + 1] += link_offsets[i];
+    }
+
+    // construct the links in place, the vectors never reallocate afterward
+    links.reserve(connections.size());
+    link_dests.reserve(connections.size());
+    for (const auto& connection : connections) {
+        // assert there's no duplicated connection
+        assert(link_dests.size() == link_offsets[connection.src] || link_dests.back() != connection.dest);
+
+        link_dests.push_back(connection.dest);
+        links.emplace_back(connection.bandwidth, connection.latency, context.get());
+    }
+
+    // attach each device to its row
+    for (auto i = 0; i < devices_count; i++) {
+        const auto offset = link_offsets[i];
+        devices[i]->set_links(link_dests.data() + offset, links.data() + offset, link_offsets[i + 1] - offset);
+    }
+
+    // release the connections
+    connections = std::vector<Connection>();
+}
+
 void Topology::instantiate_devices() noexcept {
     // instantiate all devices
     for (auto i = 0; i < devices_count; i++) {
-        devices.push_back(std::make_shared<Device>(i));
+        devices.push_back(std::make_shared<Device>(i, context.get()));
     }
 }
@@ -5,6 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/BasicTopology.h"
 #include "common/NetworkFunction.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -45,19 +46,41 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     return compute_communication_delay(hops_count, chunk_size);
 }
 
-EventTime BasicTopology::compute_communication_delay(const int hops_count, const ChunkSize chunk_size) const noexcept {
-    assert(hops_count > 0);
-    assert(chunk_size > 0);
+EventTime BasicTopology::send_within_dim(const int dim,
+                                         const DeviceId src,
+                                         const DeviceId dest,
+                                         const ChunkSize chunk_size) const noexcept {
+    assert(dim == 0);
+
+    // a basic topology has a single dimension
+    return send(src, dest, chunk_size);
+}
 
-    // compute link delay and serialization delay
-    auto link_delay = hops_count * latency;
-    auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+void BasicTopology::send_batch_range(const DeviceId* const srcs,
+                                     const DeviceId* const dests,
+                                     const ChunkSize* const chunk_sizes,
+                                     EventTime* const delays,
+                                     const size_t chunks_count) const noexcept {
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        assert(0 <= srcs[i] && srcs[i] < npus_count);
+        assert(0 <= dests[i] && dests[i] < npus_count);
+        assert(srcs[i] != dests[i]);
+        assert(chunk_sizes[i] > 0);
+    }
 
-    // comms_delay is the summation of the two
-    auto comms_delay = link_delay + serialization_delay;
+    // a single virtual call computes the hops counts of a whole block,
+    // then delays are computed as in compute_communication_delay, one block at a time
+    int hops_counts[batch_block_size];
+    for (auto begin = size_t{0}; begin < chunks_count; begin += batch_block_size) {
+        const auto block_size = std::min(batch_block_size, chunks_count - begin);
+        compute_hops_counts(srcs + begin, dests + begin, hops_counts, block_size);
 
-    // return EventTime type of comms_delay
-    return static_cast<EventTime>(comms_delay);
+        for (auto i = size_t{0}; i < block_size; i++) {
+            const auto link_delay = hops_counts[i] * latency;
+            const auto serialization_delay = static_cast<double>(chunk_sizes[begin + i]) / bandwidth_Bpns;
+            delays[begin + i] = static_cast<EventTime>(link_delay + serialization_delay);
+        }
+    }
 }
 
 TopologyBuildingBlock BasicTopology::get_basic_topology_type() const noexcept {
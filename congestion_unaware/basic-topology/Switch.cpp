@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Switch.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -19,11 +20,10 @@ Switch::Switch(const int npus_count, const Bandwidth bandwidth, const Latency la
     basic_topology_type = TopologyBuildingBlock::Switch;
 }
 
-int Switch::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
+void Switch::compute_hops_counts(const DeviceId* const,
+                                 const DeviceId* const,
+                                 int* const hops_counts,
+                                 const size_t pairs_count) const noexcept {
     // for switch, hops_count is always 2 (src -> switch -> dest)
-    return 2;
+    std::fill(hops_counts, hops_counts + pairs_count, 2);
 }
@@ -0,0 +1,15 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/StaticMultiDimTopology.h"
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+// explicit instantiations of the common shapes
+template class NetworkAnalyticalCongestionUnaware::StaticMultiDimTopology<Ring, FullyConnected, Switch>;
+template class NetworkAnalyticalCongestionUnaware::StaticMultiDimTopology<Ring, Switch>;
+template class NetworkAnalyticalCongestionUnaware::StaticMultiDimTopology<FullyConnected, Switch>;
+template class NetworkAnalyticalCongestionUnaware::StaticMultiDimTopology<Ring, Ring>;
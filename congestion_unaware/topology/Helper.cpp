@@ -8,13 +8,38 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_unaware/FullyConnected.h"
 #include "congestion_unaware/MultiDimTopology.h"
 #include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
 #include "congestion_unaware/Switch.h"
 #include <cstdlib>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
+namespace {
+
+/**
+ * Construct a multi-dimensional topology whose building blocks are known at compile time.
+ *
+ * @tparam BasicTopologies building block of each dimension, matching the network config
+ * @param network_parser parsed network config
+ * @return constructed topology
+ */
+template <typename... BasicTopologies, size_t... Dims>
+std::shared_ptr<Topology> construct_static_topology(const NetworkParser& network_parser,
+                                                    std::index_sequence<Dims...>) noexcept {
+    const auto npus_counts_per_dim = network_parser.get_npus_counts_per_dim();
+    const auto bandwidths_per_dim = network_parser.get_bandwidths_per_dim();
+    const auto latencies_per_dim = network_parser.get_latencies_per_dim();
+
+    return std::make_shared<StaticMultiDimTopology<BasicTopologies...>>(
+        BasicTopologies(npus_counts_per_dim[Dims], bandwidths_per_dim[Dims], latencies_per_dim[Dims])...);
+}
+
+}  // namespace
+
 std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology(
     const NetworkParser& network_parser) noexcept {
     // get network_parser info
@@ -47,6 +72,21 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
         }
     }
 
+    // common shapes are instantiated with their building blocks known at compile time
+    using Block = TopologyBuildingBlock;
+    if (topologies_per_dim == std::vector{Block::Ring, Block::FullyConnected, Block::Switch}) {
+        return construct_static_topology<Ring, FullyConnected, Switch>(network_parser, std::make_index_sequence<3>());
+    }
+    if (topologies_per_dim == std::vector{Block::Ring, Block::Switch}) {
+        return construct_static_topology<Ring, Switch>(network_parser, std::make_index_sequence<2>());
+    }
+    if (topologies_per_dim == std::vector{Block::FullyConnected, Block::Switch}) {
+        return construct_static_topology<FullyConnected, Switch>(network_parser, std::make_index_sequence<2>());
+    }
+    if (topologies_per_dim == std::vector{Block::Ring, Block::Ring}) {
+        return construct_static_topology<Ring, Ring>(network_parser, std::make_index_sequence<2>());
+    }
+
     // otherwise, create multi-dim basic-topology
     const auto multi_dim_topology = std::make_shared<MultiDimTopology>();
 
@@ -4,13 +4,69 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Topology.h"
+#include "common/NetworkFunction.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
 Topology::Topology() noexcept : npus_count(-1), dims_count(-1) {}
 
+void Topology::send_batch(const std::vector<DeviceId>& srcs,
+                          const std::vector<DeviceId>& dests,
+                          const std::vector<ChunkSize>& chunk_sizes,
+                          std::vector<EventTime>& delays,
+                          const int threads_count) const noexcept {
+    assert(srcs.size() == dests.size());
+    assert(srcs.size() == chunk_sizes.size());
+    assert(threads_count > 0);
+
+    const auto chunks_count = srcs.size();
+    delays.resize(chunks_count);
+
+    // only hand over ranges large enough to pay for spawning a thread
+    const auto threads_count_max = std::max(chunks_count / batch_chunks_per_thread_min, size_t{1});
+    const auto ranges_count = std::min(static_cast<size_t>(threads_count), threads_count_max);
+    if (ranges_count == 1) {
+        send_batch_range(srcs.data(), dests.data(), chunk_sizes.data(), delays.data(), chunks_count);
+        return;
+    }
+
+    // split the batch into contiguous ranges:
+    // the calling thread takes the first range, and a worker thread is spawned for each other range
+    const auto range_size = (chunks_count + ranges_count - 1) / ranges_count;
+    const auto run_range = [&](const size_t range) {
+        const auto begin = range * range_size;
+        const auto end = std::min(begin + range_size, chunks_count);
+        send_batch_range(srcs.data() + begin, dests.data() + begin, chunk_sizes.data() + begin,
+                         delays.data() + begin, end - begin);
+    };
+
+    auto workers = std::vector<std::thread>();
+    workers.reserve(ranges_count - 1);
+    for (auto range = size_t{1}; range < ranges_count; range++) {
+        workers.emplace_back(run_range, range);
+    }
+    run_range(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void Topology::send_batch_range(const DeviceId* const srcs,
+                                const DeviceId* const dests,
+                                const ChunkSize* const chunk_sizes,
+                                EventTime* const delays,
+                                const size_t chunks_count) const noexcept {
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        delays[i] = send(srcs[i], dests[i], chunk_sizes[i]);
+    }
+}
+
 int Topology::get_npus_count() const noexcept {
     assert(npus_count > 0);
 
@@ -34,3 +90,117 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
 
     return bandwidth_per_dim;
 }
+
+EventTime Topology::estimate_collective(const CollectiveType type,
+                                        const CollectiveAlgorithm algorithm,
+                                        const ChunkSize size) const noexcept {
+    assert(size > 0);
+
+    // flat algorithms span every dimension at once
+    if (algorithm != CollectiveAlgorithm::Hierarchical) {
+        const auto last_dim = dims_count - 1;
+        if (type == CollectiveType::AllReduce) {
+            return estimate_phase(CollectiveType::ReduceScatter, algorithm, 0, last_dim, size) +
+                   estimate_phase(CollectiveType::AllGather, algorithm, 0, last_dim, size);
+        }
+        return estimate_phase(type, algorithm, 0, last_dim, size);
+    }
+
+    // hierarchical: each phase runs within a single dimension
+    auto collective_time = EventTime{0};
+    for (const auto& phase : hierarchical_phases(type, npus_count_per_dim, size)) {
+        collective_time += estimate_phase(phase.type, phase.algorithm, phase.dim, phase.dim, phase.data_size);
+    }
+    return collective_time;
+}
+
+EventTime Topology::estimate_phase(const CollectiveType type,
+                                   const CollectiveAlgorithm algorithm,
+                                   const int first_dim,
+                                   const int last_dim,
+                                   const ChunkSize data_size) const noexcept {
+    assert(type != CollectiveType::AllReduce);
+    assert(0 <= first_dim && first_dim <= last_dim && last_dim < dims_count);
+
+    // number of NPUs exchanging data in the phase
+    auto group_size = uint64_t{1};
+    for (auto dim = first_dim; dim <= last_dim; dim++) {
+        group_size *= npus_count_per_dim[dim];
+    }
+    if (group_size == 1) {
+        return 0;
+    }
+    const auto chunk_size = part_size(data_size, group_size);
+
+    auto phase_time = EventTime{0};
+    switch (algorithm) {
+    case CollectiveAlgorithm::Ring: {
+        // every step sends to the next NPU
+        if (type != CollectiveType::AllToAll) {
+            return (group_size - 1) * send_to_offset(first_dim, last_dim, 1, chunk_size);
+        }
+
+        // all-to-all: step s sends to the NPU s apart, and the offsets whose lowest nonzero digit
+        // is j in dimension k occur once per combination of the digits of the higher dimensions
+        auto multiplicity = group_size;
+        for (auto dim = first_dim; dim <= last_dim; dim++) {
+            multiplicity /= npus_count_per_dim[dim];
+            for (auto digit = 1; digit < npus_count_per_dim[dim]; digit++) {
+                phase_time += multiplicity * send_within_dim(dim, 0, digit, chunk_size);
+            }
+        }
+        return phase_time;
+    }
+    case CollectiveAlgorithm::Direct:
+        // a single step, as long as the farthest send
+        for (auto dim = first_dim; dim <= last_dim; dim++) {
+            for (auto digit = 1; digit < npus_count_per_dim[dim]; digit++) {
+                phase_time = std::max(phase_time, send_within_dim(dim, 0, digit, chunk_size));
+            }
+        }
+        return phase_time;
+    case CollectiveAlgorithm::HalvingDoubling:
+        if ((group_size & (group_size - 1)) != 0) {
+            std::cerr << "[Error] (network/analytical/congestion_unaware) "
+                      << "halving-doubling requires a power-of-two number of NPUs, got " << group_size
+                      << std::endl;
+            std::exit(-1);
+        }
+
+        // NPU i exchanges with i xor distance, which is distance apart in either direction
+        for (auto distance = uint64_t{1}; distance < group_size; distance <<= 1) {
+            const auto step_chunk_size = (type == CollectiveType::AllToAll)
+                                             ? part_size(data_size, 2)
+                                             : part_size(data_size, group_size / distance);
+            phase_time += std::max(send_to_offset(first_dim, last_dim, distance, step_chunk_size),
+                                   send_to_offset(first_dim, last_dim, group_size - distance, step_chunk_size));
+        }
+        return phase_time;
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical/congestion_unaware) "
+                  << "not supported collective algorithm for a phase" << std::endl;
+        std::exit(-1);
+    }
+}
+
+EventTime Topology::send_to_offset(const int first_dim,
+                                   const int last_dim,
+                                   uint64_t offset,
+                                   const ChunkSize chunk_size) const noexcept {
+    assert(offset > 0);
+
+    // the chunk crosses the lowest dimension where the address changes
+    for (auto dim = first_dim; dim <= last_dim; dim++) {
+        const auto dim_size = static_cast<uint64_t>(npus_count_per_dim[dim]);
+        const auto digit = static_cast<DeviceId>(offset % dim_size);
+        if (digit != 0) {
+            return send_within_dim(dim, 0, digit, chunk_size);
+        }
+        offset /= dim_size;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_unaware) " << "offset spans no NPU" << std::endl;
+    std::exit(-1);
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Event.h"
+#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * BinaryHeapScheduler keeps events in a binary min-heap keyed by (event time, scheduling order).
+ *
+ * Both scheduling and popping an event take O(log(pending events)),
+ * regardless of how the event times are distributed.
+ */
+class BinaryHeapScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    BinaryHeapScheduler() noexcept;
+
+    /**
+     * Implementation of empty function in EventScheduler.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of front_time function in EventScheduler.
+     */
+    [[nodiscard]] EventTime front_time() const noexcept override;
+
+    /**
+     * Implementation of schedule function in EventScheduler.
+     */
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop function in EventScheduler.
+     */
+    [[nodiscard]] EventList pop() noexcept override;
+
+  private:
+    /**
+     * HeapEntry is a scheduled event with its ordering key.
+     */
+    struct HeapEntry {
+        /// event time of the event
+        EventTime event_time;
+
+        /// scheduling order of the event, breaks ties of the event time in FIFO order
+        uint64_t sequence;
+
+        /// the scheduled event
+        Event event;
+
+        /**
+         * Heap ordering, std heap algorithms build a max-heap so the comparison is reversed.
+         */
+        bool operator<(const HeapEntry& other) const noexcept {
+            if (event_time != other.event_time) {
+                return event_time > other.event_time;
+            }
+            return sequence > other.sequence;
+        }
+    };
+
+    /// heap of scheduled events
+    std::vector<HeapEntry> heap;
+
+    /// scheduling order to be assigned to the next event
+    uint64_t next_sequence;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,126 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * CalendarScheduler orders EventLists with a calendar queue
+ * (R. Brown, "Calendar Queues", CACM 1988).
+ *
+ * Event times are hashed into a circular array of buckets ("days"),
+ * each covering bucket_width ns. Each bucket keeps its EventLists sorted
+ * in a chain of pooled EventListNodes,
+ * and the bucket count is doubled/halved as the queue grows/shrinks
+ * so that insertion and removal of the earliest EventList are amortized O(1).
+ *
+ * Events scheduled at the same time are grouped into a single EventList,
+ * and events within an EventList are kept in FIFO order.
+ */
+class CalendarScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    CalendarScheduler() noexcept;
+
+    /**
+     * Implementation of empty function in EventScheduler.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of front_time function in EventScheduler.
+     */
+    [[nodiscard]] EventTime front_time() const noexcept override;
+
+    /**
+     * Implementation of schedule function in EventScheduler.
+     * If no EventList exists for the event time, a new one is created.
+     */
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop function in EventScheduler.
+     */
+    [[nodiscard]] EventList pop() noexcept override;
+
+  private:
+    /// a bucket is the first node of an EventList chain, sorted by event time
+    using Bucket = EventListNode*;
+
+    /// minimum number of buckets
+    static constexpr size_t min_buckets_count = 2;
+
+    /// number of EventLists sampled to estimate the bucket width
+    static constexpr size_t width_samples_count = 25;
+
+    /// circular array of buckets, size is always a power of 2
+    std::vector<Bucket> buckets;
+
+    /// time span covered by a single bucket
+    EventTime bucket_width;
+
+    /// index of the bucket the last EventList was popped from
+    size_t current_bucket;
+
+    /// upper bound (exclusive) of the time range current_bucket covers
+    EventTime bucket_top;
+
+    /// event time of the last popped EventList
+    EventTime last_time;
+
+    /// number of registered EventLists
+    size_t event_lists_count;
+
+    /// scratch space to estimate the bucket width, kept to avoid reallocation
+    std::vector<EventTime> width_samples;
+
+    /**
+     * Compute the bucket index the given event time should be hashed into.
+     *
+     * @param event_time event time
+     * @return bucket index
+     */
+    [[nodiscard]] size_t bucket_index(EventTime event_time) const noexcept;
+
+    /**
+     * Locate the bucket holding the earliest EventList.
+     *
+     * @return index of the bucket, and the upper bound (exclusive) of the time range it covers
+     */
+    [[nodiscard]] std::pair<size_t, EventTime> find_earliest() const noexcept;
+
+    /**
+     * Link a detached EventList node into its sorted position of the corresponding bucket.
+     *
+     * @param node EventList node to link
+     */
+    void insert_sorted(EventListNode* node) noexcept;
+
+    /**
+     * Estimate a good bucket width from the separation of the earliest EventLists.
+     *
+     * @return estimated bucket width
+     */
+    [[nodiscard]] EventTime estimate_bucket_width() noexcept;
+
+    /**
+     * Re-hash all EventLists into the given number of buckets.
+     *
+     * @param new_buckets_count number of buckets after resizing
+     */
+    void resize(size_t new_buckets_count) noexcept;
+};
+
+}  // namespace NetworkAnalytical
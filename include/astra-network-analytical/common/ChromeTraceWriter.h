@@ -0,0 +1,170 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+namespace NetworkAnalytical {
+
+/**
+ * Hop of a chunk over a single link, as recorded by ChromeTraceWriter.
+ */
+struct ChunkHopRecord {
+    /// id of the device the link leaves from
+    DeviceId src;
+
+    /// id of the device the link leads to
+    DeviceId dest;
+
+    /// id of the device the chunk was sent from
+    DeviceId chunk_src;
+
+    /// id of the destination device of the chunk
+    DeviceId chunk_dest;
+
+    /// size of the chunk
+    ChunkSize chunk_size;
+
+    /// time the chunk reached the link
+    EventTime ready_time;
+
+    /// time the link started serializing the chunk
+    EventTime start_time;
+
+    /// time the link finished serializing the chunk
+    EventTime end_time;
+
+    /// time the chunk arrives at the device the link leads to
+    EventTime arrival_time;
+};
+
+/**
+ * ChromeTraceWriter streams chunk hops as Chrome trace-event JSON,
+ * loadable by chrome://tracing and the Perfetto UI.
+ *
+ * Each link is a track (thread dest within process src), where a hop shows as
+ * an enqueue instant, a complete event spanning its serialization, i.e., the link busy interval,
+ * and an arrival instant. Events are buffered in a small text buffer flushed to the output
+ * as it fills up, so memory doesn't grow with the length of the run.
+ * Safe to call concurrently.
+ */
+class ChromeTraceWriter {
+  public:
+    /**
+     * Constructor, writing to a file.
+     *
+     * @param path path of the trace file
+     */
+    explicit ChromeTraceWriter(const std::string& path) noexcept;
+
+    /**
+     * Constructor, writing to a stream the caller keeps alive until the writer is closed.
+     *
+     * @param output stream to write to
+     */
+    explicit ChromeTraceWriter(std::ostream& output) noexcept;
+
+    /**
+     * Destructor, closing the trace.
+     */
+    ~ChromeTraceWriter() noexcept;
+
+    /**
+     * Record the hop of a chunk over a link.
+     *
+     * @param hop hop to record
+     */
+    void record(const ChunkHopRecord& hop) noexcept;
+
+    /**
+     * Flush the buffered events and terminate the trace.
+     * Further hops are ignored.
+     */
+    void close() noexcept;
+
+    /**
+     * Get the number of hops recorded so far.
+     *
+     * @return number of recorded hops
+     */
+    [[nodiscard]] uint64_t get_hops_count() const noexcept;
+
+  private:
+    /// size of the text buffer flushed to the output
+    static constexpr size_t buffer_size = 1 << 20;
+
+    /// trace file, if the writer owns it
+    std::unique_ptr<std::ofstream> file;
+
+    /// stream the trace is written to
+    std::ostream* output;
+
+    /// events not flushed to the output yet
+    std::string buffer;
+
+    /// links whose track has been named, keyed by (src << 32) | dest
+    std::unordered_set<uint64_t> named_links;
+
+    /// devices whose process has been named
+    std::unordered_set<DeviceId> named_devices;
+
+    /// number of events written so far, metadata included
+    uint64_t events_count;
+
+    /// number of hops recorded so far
+    uint64_t hops_count;
+
+    /// whether the trace has been terminated
+    bool closed;
+
+    /// guards every member above
+    mutable std::mutex mutex;
+
+    /**
+     * Name the track of a link, and the process of its src device, at their first use.
+     *
+     * @param src id of the device the link leaves from
+     * @param dest id of the device the link leads to
+     */
+    void name_track(DeviceId src, DeviceId dest) noexcept;
+
+    /**
+     * Start a new event, separated from the previous one.
+     */
+    void begin_event() noexcept;
+
+    /**
+     * Append an event header up to its arguments, i.e., {"name": ..., "ph": ..., "ts": ..., "pid": ..., "tid": ...
+     *
+     * @param name name of the event
+     * @param phase phase of the event, e.g., "X" for complete events
+     * @param time time of the event in ns
+     * @param src id of the device the link leaves from
+     * @param dest id of the device the link leads to
+     */
+    void append_event(const char* name, const char* phase, EventTime time, DeviceId src, DeviceId dest) noexcept;
+
+    /**
+     * Append a time in ns as a value in us, the unit of Chrome traces.
+     *
+     * @param time time in ns
+     */
+    void append_time(EventTime time) noexcept;
+
+    /**
+     * Write the buffered events to the output.
+     */
+    void flush() noexcept;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,30 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <optional>
+#include <string>
+
+namespace NetworkAnalytical {
+
+/**
+ * Parse the name of a collective communication pattern.
+ *
+ * @param name name of the collective, i.e., "AllReduce", "ReduceScatter", "AllGather", or "AllToAll"
+ * @return parsed CollectiveType, or std::nullopt if the name is unknown
+ */
+[[nodiscard]] std::optional<CollectiveType> parse_collective_type(const std::string& name) noexcept;
+
+/**
+ * Parse the name of a collective algorithm.
+ *
+ * @param name name of the algorithm, i.e., "Ring", "Direct", "HalvingDoubling", or "Hierarchical"
+ * @return parsed CollectiveAlgorithm, or std::nullopt if the name is unknown
+ */
+[[nodiscard]] std::optional<CollectiveAlgorithm> parse_collective_algorithm(const std::string& name) noexcept;
+
+}  // namespace NetworkAnalytical
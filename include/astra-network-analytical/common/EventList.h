@@ -6,22 +6,63 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Event.h"
+#include "common/ObjectPool.h"
 #include "common/Type.h"
-#include <list>
 
 namespace NetworkAnalytical {
 
 /**
  * EventList encapsulates a number of Events along with its event time.
+ *
+ * Events are kept in an intrusive FIFO list of nodes drawn from an ObjectPool,
+ * so registering and invoking events doesn't touch the heap once the pool is warmed up.
+ * EventList is move-only: moving hands over the registered events without copying them.
  */
 class EventList {
   public:
+    /**
+     * Node of the intrusive event list.
+     */
+    struct Node {
+        /// registered event
+        Event event;
+
+        /// next node in the list
+        Node* next;
+    };
+
+    /// pool to allocate event nodes from
+    using NodePool = ObjectPool<Node>;
+
     /**
      * Constructor.
      *
      * @param event_time event time of the event list
+     * @param node_pool pool to allocate event nodes from
+     */
+    EventList(EventTime event_time, NodePool* node_pool) noexcept;
+
+    /**
+     * Move constructor.
+     * The registered events are handed over to the new event list.
+     */
+    EventList(EventList&& other) noexcept;
+
+    /**
+     * Move assignment.
+     * Registered events of this list are dropped, and those of other are handed over.
+     */
+    EventList& operator=(EventList&& other) noexcept;
+
+    /// events are owned by a single event list, so EventList cannot be copied
+    EventList(const EventList&) = delete;
+    EventList& operator=(const EventList&) = delete;
+
+    /**
+     * Destructor.
+     * Events not invoked yet are dropped and their nodes returned to the pool.
      */
-    explicit EventList(EventTime event_time) noexcept;
+    ~EventList() noexcept;
 
     /**
      * Get the registered event time.
@@ -40,19 +81,32 @@ class EventList {
 
     /**
      * Invoke all events in the event list.
+     * Each node is returned to the pool before its event is invoked,
+     * so events scheduled by the callback can reuse it right away.
      */
     void invoke_events() noexcept;
 
     bool is_empty() const noexcept {
-        return events.empty();
+        return head == nullptr;
     }
 
   private:
     /// event time of the event list
     EventTime event_time;
 
-    /// list of registered events
-    std::list<Event> events;
+    /// pool the event nodes are allocated from
+    NodePool* node_pool;
+
+    /// first registered event
+    Node* head;
+
+    /// last registered event
+    Node* tail;
+
+    /**
+     * Return all registered nodes to the pool.
+     */
+    void clear() noexcept;
 };
 
 }  // namespace NetworkAnalytical
@@ -6,7 +6,10 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventList.h"
+#include "common/EventScheduler.h"
 #include "common/Type.h"
+#include <cstdint>
+#include <memory>
 
 namespace NetworkAnalytical {
 
@@ -17,8 +20,10 @@ class EventQueue {
   public:
     /**
      * Constructor.
+     *
+     * @param policy data structure used to order the scheduled events
      */
-    EventQueue() noexcept;
+    explicit EventQueue(EventSchedulerPolicy policy = EventSchedulerPolicy::Calendar) noexcept;
 
     /**
      * Get current event time of the event queue.
@@ -35,6 +40,14 @@ class EventQueue {
      */
     [[nodiscard]] bool finished() const noexcept;
 
+    /**
+     * Get the time of the earliest registered event.
+     * The event queue should not be finished.
+     *
+     * @return time of the earliest registered event
+     */
+    [[nodiscard]] EventTime get_next_event_time() const noexcept;
+
     /**
      * Proceed the event queue.
      * i.e., first update the current event time to the next registered event
@@ -52,12 +65,22 @@ class EventQueue {
      */
     void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Get the number of events scheduled since the event queue was constructed.
+     *
+     * @return number of scheduled events
+     */
+    [[nodiscard]] uint64_t get_scheduled_events_count() const noexcept;
+
   private:
     /// current time of the event queue
     EventTime current_time;
 
-    /// list of EventLists
-    std::list<EventList> event_queue;
+    /// number of events scheduled so far
+    uint64_t scheduled_events_count;
+
+    /// scheduled events, ordered by event time
+    std::unique_ptr<EventScheduler> event_queue;
 };
 
 }  // namespace NetworkAnalytical
@@ -0,0 +1,96 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/ObjectPool.h"
+#include "common/Type.h"
+#include <memory>
+
+namespace NetworkAnalytical {
+
+/**
+ * Data structure an EventQueue uses to order scheduled events.
+ *   - List: sorted linked list, cheapest for a handful of pending timestamps
+ *   - BinaryHeap: binary min-heap, robust for sparse timestamps
+ *   - RadixHeap: radix heap, exploits monotone integer event times
+ *   - Calendar: calendar queue, amortized O(1) for dense timestamps
+ */
+enum class EventSchedulerPolicy { List, BinaryHeap, RadixHeap, Calendar };
+
+/**
+ * EventScheduler is an interface of priority queues of events ordered by event time.
+ *
+ * Every implementation must guarantee that:
+ *   - events with the same event time are popped together as a single EventList,
+ *   - events within an EventList are ordered in FIFO (scheduling) order,
+ *   - events scheduled at the last popped event time are popped by the next pop().
+ */
+class EventScheduler {
+  public:
+    /**
+     * Create an EventScheduler implementing the given policy.
+     *
+     * @param policy policy of the scheduler
+     * @return pointer to the created scheduler
+     */
+    [[nodiscard]] static std::unique_ptr<EventScheduler> create(EventSchedulerPolicy policy) noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~EventScheduler() noexcept;
+
+    /**
+     * Check whether the scheduler is empty.
+     *
+     * @return true if no event is registered, false otherwise
+     */
+    [[nodiscard]] virtual bool empty() const noexcept = 0;
+
+    /**
+     * Get the smallest registered event time, without removing any event.
+     *
+     * @return smallest registered event time, the scheduler should not be empty
+     */
+    [[nodiscard]] virtual EventTime front_time() const noexcept = 0;
+
+    /**
+     * Register an event.
+     *
+     * @param event_time time of event, should not be smaller than the last popped event time
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    virtual void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept = 0;
+
+    /**
+     * Remove and return all events with the smallest event time.
+     *
+     * @return EventList holding the events with the smallest event time
+     */
+    [[nodiscard]] virtual EventList pop() noexcept = 0;
+
+  protected:
+    /**
+     * EventListNode chains EventLists into an intrusive singly-linked list.
+     */
+    struct EventListNode {
+        /// the chained EventList
+        EventList event_list;
+
+        /// next node in the chain
+        EventListNode* next;
+    };
+
+    /// pool of the event nodes registered into EventLists of this scheduler
+    EventList::NodePool event_node_pool;
+
+    /// pool of EventListNodes, for schedulers chaining EventLists
+    ObjectPool<EventListNode> event_list_node_pool;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,82 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace NetworkAnalytical {
+
+/**
+ * FastDivider divides 32-bit unsigned integers by a fixed divisor
+ * with a multiplication instead of a hardware division.
+ *
+ * The magic multiplier is ceil(2^64 / divisor), for which the high 64 bits of
+ * multiplier * dividend are exactly dividend / divisor for every 32-bit dividend
+ * (Lemire et al., "Faster Remainder by Direct Computation", 2019).
+ * The remainder is computed directly from the low 64 bits of the same product.
+ *
+ * The 128-bit products rely on unsigned __int128, a GNU extension supported by GCC and Clang.
+ */
+class FastDivider {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param divisor divisor, at least 1
+     */
+    explicit FastDivider(const uint32_t divisor) noexcept
+        : divisor(divisor),
+          multiplier(UINT64_C(0xFFFFFFFFFFFFFFFF) / divisor + 1) {
+        assert(divisor > 0);
+    }
+
+    /**
+     * Get the divisor.
+     *
+     * @return divisor
+     */
+    [[nodiscard]] uint32_t get_divisor() const noexcept {
+        return divisor;
+    }
+
+    /**
+     * Divide a value by the divisor.
+     *
+     * @param dividend value to divide
+     * @return dividend / divisor
+     */
+    [[nodiscard]] uint32_t divide(const uint32_t dividend) const noexcept {
+        // dividing by 1 overflows the multiplier to 0
+        if (divisor == 1) {
+            return dividend;
+        }
+
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(multiplier) * dividend) >> 64);
+    }
+
+    /**
+     * Get the remainder of a value divided by the divisor.
+     *
+     * @param dividend value to divide
+     * @return dividend % divisor
+     */
+    [[nodiscard]] uint32_t modulo(const uint32_t dividend) const noexcept {
+        // the fraction of dividend / divisor, scaled by 2^64, times the divisor
+        // (a divisor of 1 has a zero multiplier, hence always a zero remainder)
+        const auto fraction = multiplier * dividend;
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(fraction) * divisor) >> 64);
+    }
+
+  private:
+    /// divisor
+    uint32_t divisor;
+
+    /// ceil(2^64 / divisor), wrapping to 0 for a divisor of 1
+    uint64_t multiplier;
+};
+
+}  // namespace NetworkAnalytical
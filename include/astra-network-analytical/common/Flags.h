@@ -1,14 +0,0 @@
-#pragma once
-
-#include <iostream>
-#include <string>
-
-namespace NetworkAnalytical {
-
-/**
- * Global verbose logging flag.
- * Set to true to enable debug logging in analytical backend.
- */
-constexpr bool DEBUG_PRINT = false;
-
-} // namespace NetworkAnalytical
@@ -0,0 +1,192 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * LinkTelemetry holds the counters of a single link, collected when link telemetry is enabled:
+ * bytes and chunks transmitted, busy time, depth of the queue of pending chunks,
+ * and a histogram of the time chunks waited for the link.
+ */
+class LinkTelemetry {
+  public:
+    /// number of buckets of the queueing delay histogram:
+    /// bucket 0 counts chunks which didn't wait, bucket i counts delays in [2^(i-1), 2^i) ns,
+    /// and the last bucket counts every longer delay
+    static constexpr size_t histogram_buckets_count = 48;
+
+    /**
+     * Get the histogram bucket counting a queueing delay.
+     *
+     * @param queueing_delay time a chunk waited for the link
+     * @return index of the bucket
+     */
+    [[nodiscard]] static size_t histogram_bucket(EventTime queueing_delay) noexcept;
+
+    /**
+     * Constructor.
+     */
+    LinkTelemetry() noexcept;
+
+    /**
+     * Record the transmission of a chunk.
+     *
+     * @param ready_time time the chunk reached the link
+     * @param start_time time the link started serializing the chunk
+     * @param end_time time the link finished serializing the chunk
+     * @param chunk_size size of the chunk
+     */
+    void record_transmission(EventTime ready_time, EventTime start_time, EventTime end_time, ChunkSize chunk_size)
+        noexcept;
+
+    /**
+     * Cancel a transmission recorded ahead of time, which didn't take place.
+     *
+     * @param ready_time time the chunk reached the link, as recorded
+     * @param start_time time the link started serializing the chunk, as recorded
+     * @param end_time time the link finished serializing the chunk, as recorded
+     * @param chunk_size size of the chunk
+     */
+    void cancel_transmission(EventTime ready_time, EventTime start_time, EventTime end_time, ChunkSize chunk_size)
+        noexcept;
+
+    /**
+     * Record a change of the number of chunks waiting for the link.
+     *
+     * @param time time of the change
+     * @param queue_depth number of chunks waiting after the change
+     */
+    void record_queue_depth(EventTime time, size_t queue_depth) noexcept;
+
+    /**
+     * Get the number of bytes transmitted.
+     *
+     * @return number of bytes transmitted
+     */
+    [[nodiscard]] uint64_t get_bytes() const noexcept;
+
+    /**
+     * Get the number of chunks transmitted.
+     *
+     * @return number of chunks transmitted
+     */
+    [[nodiscard]] uint64_t get_chunks_count() const noexcept;
+
+    /**
+     * Get the time the link spent serializing chunks.
+     *
+     * @return busy time of the link
+     */
+    [[nodiscard]] EventTime get_busy_time() const noexcept;
+
+    /**
+     * Get the number of chunks waiting for the link, as last recorded.
+     *
+     * @return current queue depth
+     */
+    [[nodiscard]] size_t get_queue_depth() const noexcept;
+
+    /**
+     * Get the largest number of chunks which waited for the link at once.
+     *
+     * @return maximum queue depth
+     */
+    [[nodiscard]] size_t get_max_queue_depth() const noexcept;
+
+    /**
+     * Get the number of chunks waiting for the link, averaged over time since the simulation started.
+     *
+     * @param end_time end of the averaging period, no earlier than the last recorded change
+     * @return time-weighted mean queue depth
+     */
+    [[nodiscard]] double get_mean_queue_depth(EventTime end_time) const noexcept;
+
+    /**
+     * Get the average time chunks waited for the link.
+     *
+     * @return mean queueing delay
+     */
+    [[nodiscard]] double get_mean_queueing_delay() const noexcept;
+
+    /**
+     * Get the histogram of the time chunks waited for the link.
+     *
+     * @return number of chunks per bucket, see histogram_bucket
+     */
+    [[nodiscard]] const std::array<uint64_t, histogram_buckets_count>& get_queueing_delay_histogram() const noexcept;
+
+  private:
+    /// number of bytes transmitted
+    uint64_t bytes;
+
+    /// number of chunks transmitted
+    uint64_t chunks_count;
+
+    /// time spent serializing chunks
+    EventTime busy_time;
+
+    /// sum of the queueing delays of every chunk
+    EventTime total_queueing_delay;
+
+    /// number of chunks waiting for the link since the last change
+    size_t queue_depth;
+
+    /// largest number of chunks which waited at once
+    size_t max_queue_depth;
+
+    /// time of the last change of the queue depth
+    EventTime last_queue_change_time;
+
+    /// integral of the queue depth over time, up to last_queue_change_time
+    double queue_depth_area;
+
+    /// number of chunks per queueing delay bucket
+    std::array<uint64_t, histogram_buckets_count> queueing_delay_histogram;
+};
+
+/**
+ * Telemetry of the link from src device to dest device.
+ */
+struct LinkTelemetryEntry {
+    /// id of the device the link leaves from
+    DeviceId src;
+
+    /// id of the device the link leads to
+    DeviceId dest;
+
+    /// counters of the link
+    LinkTelemetry telemetry;
+};
+
+/**
+ * Write link telemetry as CSV, one row per link.
+ *
+ * @param entries telemetry of the links, ordered as they should be written
+ * @param end_time end of the run, averaging the queue depths
+ * @param output stream to write to
+ */
+void write_link_telemetry_csv(const std::vector<LinkTelemetryEntry>& entries, EventTime end_time, std::ostream& output)
+    noexcept;
+
+/**
+ * Write link telemetry as a JSON array, one object per link.
+ *
+ * @param entries telemetry of the links, ordered as they should be written
+ * @param end_time end of the run, averaging the queue depths
+ * @param output stream to write to
+ */
+void write_link_telemetry_json(const std::vector<LinkTelemetryEntry>& entries, EventTime end_time, std::ostream& output)
+    noexcept;
+
+}  // namespace NetworkAnalytical
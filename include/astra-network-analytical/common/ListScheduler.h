@@ -0,0 +1,52 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+
+namespace NetworkAnalytical {
+
+/**
+ * ListScheduler keeps EventLists in a linked list sorted by event time.
+ *
+ * Scheduling an event walks the list from the front, i.e., O(pending timestamps),
+ * so this is only suitable for small simulations with a handful of pending timestamps.
+ */
+class ListScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    ListScheduler() noexcept;
+
+    /**
+     * Implementation of empty function in EventScheduler.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of front_time function in EventScheduler.
+     */
+    [[nodiscard]] EventTime front_time() const noexcept override;
+
+    /**
+     * Implementation of schedule function in EventScheduler.
+     */
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop function in EventScheduler.
+     */
+    [[nodiscard]] EventList pop() noexcept override;
+
+  private:
+    /// first node of the EventList chain, sorted by event time
+    EventListNode* head;
+};
+
+}  // namespace NetworkAnalytical
@@ -6,7 +6,8 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
-#include <string>
+#include <cstdint>
+#include <vector>
 
 namespace NetworkAnalytical {
 
@@ -21,8 +22,43 @@ namespace NetworkAnalytical {
 Bandwidth bw_GBps_to_Bpns(Bandwidth bw_GBps) noexcept;
 
 /**
- * Debug logger.
+ * Get the size of a chunk carrying a fraction of a buffer.
+ *
+ * @param size size of the buffer
+ * @param parts_count number of parts the buffer is divided into
+ * @return size of each part, at least a byte
+ */
+ChunkSize part_size(ChunkSize size, uint64_t parts_count) noexcept;
+
+/**
+ * Phase of a hierarchical collective, running within a single network dimension.
+ */
+struct HierarchicalPhase {
+    /// collective run within the dimension (ReduceScatter, AllGather or AllToAll)
+    CollectiveType type;
+
+    /// algorithm of the phase (Ring, or Direct for AllToAll)
+    CollectiveAlgorithm algorithm;
+
+    /// dimension the phase runs in
+    int dim;
+
+    /// size of the buffer of each NPU during the phase
+    ChunkSize data_size;
+};
+
+/**
+ * Decompose a hierarchical collective into its per-dimension phases, in order.
+ * ReduceScatter shrinks the buffer from the first dimension up, and AllGather grows it back
+ * from the last dimension down. AllToAll exchanges the whole buffer within each dimension.
+ *
+ * @param type collective type
+ * @param npus_count_per_dim number of NPUs in each dimension
+ * @param size size of the buffer of each NPU
+ * @return phases of the collective
  */
-void debug_log(const std::string& msg) noexcept;
+std::vector<HierarchicalPhase> hierarchical_phases(CollectiveType type,
+                                                   const std::vector<int>& npus_count_per_dim,
+                                                   ChunkSize size) noexcept;
 
 }  // namespace NetworkAnalytical
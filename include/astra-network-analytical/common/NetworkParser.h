@@ -7,10 +7,19 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include <iostream>
+#include <stdexcept>
 #include <yaml-cpp/yaml.h>
 
 namespace NetworkAnalytical {
 
+/**
+ * NetworkConfigError is thrown when a network configuration is invalid.
+ */
+class NetworkConfigError : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
 /**
  * NetworkParser parses the network configuration file in YAML format.
  */
@@ -18,11 +27,20 @@ class NetworkParser {
   public:
     /**
      * Constructor.
+     * Exits if the file can't be read or holds an invalid network configuration.
      *
      * @param path path of the yml file
      */
     explicit NetworkParser(const std::string& path) noexcept;
 
+    /**
+     * Constructor, from a network configuration already loaded as a YAML node.
+     *
+     * @param network_config YAML node holding the network configuration
+     * @throws NetworkConfigError if the network configuration is invalid
+     */
+    explicit NetworkParser(const YAML::Node& network_config);
+
     /**
      * Return the number of network dimensions.
      * Which is calculated by the length of "topology" value
@@ -88,20 +106,20 @@ class NetworkParser {
      *    which can be "Ring", "FullyConnected", or "Switch"
      * @return parsed TopologyBuildingBlock enum class value
      */
-    [[nodiscard]] static TopologyBuildingBlock parse_topology_name(const std::string& topology_name) noexcept;
+    [[nodiscard]] static TopologyBuildingBlock parse_topology_name(const std::string& topology_name);
 
     /**
      * Parse the given YAML node and retrieve network configuration values
      *
      * @param network_config opened and parsed YAML node
      */
-    void parse_network_config_yml(const YAML::Node& network_config) noexcept;
+    void parse_network_config_yml(const YAML::Node& network_config);
 
     /**
      * Check the validity and correctness of the parsed network input
      * configurations.
      */
-    void check_validity() const noexcept;
+    void check_validity() const;
 
     /**
      * Given a yaml node whose type is list of type T,
@@ -111,7 +129,7 @@ class NetworkParser {
      * @param node YAML node (in list type) to read
      * @return std::vector<T> of read elements
      */
-    template <typename T> std::vector<T> parse_vector(const YAML::Node& node) const noexcept {
+    template <typename T> std::vector<T> parse_vector(const YAML::Node& node) const {
         // create empty vector to store parsed values
         auto parsed_vector = std::vector<T>();
 
@@ -125,8 +143,7 @@ class NetworkParser {
                 parsed_vector.push_back(element_value);
             } catch (const YAML::BadConversion& e) {
                 // error reading an element from the yaml file as type T
-                std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
-                std::exit(-1);
+                throw NetworkConfigError(e.what());
             }
         }
 
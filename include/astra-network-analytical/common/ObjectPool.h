@@ -0,0 +1,116 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * ObjectPool is a slab allocator for objects of type T.
+ *
+ * Objects are carved out of slabs holding slab_size objects each,
+ * and released objects are kept in an intrusive free list to be reused.
+ * Slabs are only returned to the system when the pool is destructed,
+ * so once the pool has grown to the peak number of live objects,
+ * allocation and release never call malloc/free.
+ *
+ * @tparam T type of the pooled objects
+ */
+template <typename T> class ObjectPool {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param slab_size number of objects per slab
+     */
+    explicit ObjectPool(size_t slab_size = 1'024) noexcept : slab_size(slab_size), free_list(nullptr) {
+        assert(slab_size > 0);
+    }
+
+    /// pooled objects point into the slabs, so the pool cannot be copied or moved
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * Construct an object in the pool.
+     *
+     * @param args arguments forwarded to the constructor of T
+     * @return pointer to the constructed object
+     */
+    template <typename... Args> [[nodiscard]] T* allocate(Args&&... args) noexcept {
+        if (free_list == nullptr) {
+            // no free slot left, carve a new slab
+            grow();
+        }
+
+        // pop a free slot
+        auto* const slot = free_list;
+        free_list = slot->next_free;
+
+        // construct the object in the slot
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Destruct an object and return its slot to the pool.
+     *
+     * @param object pointer to the object, which must have been allocated by this pool
+     */
+    void release(T* const object) noexcept {
+        assert(object != nullptr);
+
+        // destruct the object
+        object->~T();
+
+        // push the slot into the free list
+        auto* const slot = reinterpret_cast<Slot*>(object);
+        slot->next_free = free_list;
+        free_list = slot;
+    }
+
+  private:
+    /**
+     * Slot holds either a live object or a link to the next free slot.
+     */
+    union Slot {
+        /// next free slot, valid only while the slot is free
+        Slot* next_free;
+
+        /// storage of the object
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /// number of objects per slab
+    size_t slab_size;
+
+    /// allocated slabs
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+
+    /// head of the free slot list
+    Slot* free_list;
+
+    /**
+     * Allocate a new slab and push its slots into the free list.
+     */
+    void grow() noexcept {
+        slabs.push_back(std::make_unique<Slot[]>(slab_size));
+        auto* const slab = slabs.back().get();
+
+        // link the slots in address order
+        for (auto i = slab_size; i > 0; i--) {
+            slab[i - 1].next_free = free_list;
+            free_list = &slab[i - 1];
+        }
+    }
+};
+
+}  // namespace NetworkAnalytical
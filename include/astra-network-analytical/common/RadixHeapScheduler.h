@@ -0,0 +1,114 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Event.h"
+#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/ObjectPool.h"
+#include "common/Type.h"
+#include <array>
+#include <cstddef>
+
+namespace NetworkAnalytical {
+
+/**
+ * RadixHeapScheduler keeps events in a radix heap (Ahuja et al., "Faster Algorithms for
+ * the Shortest Path Problem", JACM 1990).
+ *
+ * Radix heaps exploit the fact that event times are monotone integers:
+ * bucket i holds events whose time differs from the last popped time at bit (i - 1)
+ * as the most significant differing bit. Scheduling is O(1) and
+ * each event is redistributed at most 64 times, giving O(1) amortized pop for EventTime.
+ *
+ * Events are only ever appended or moved in order, so events sharing an event time
+ * keep their FIFO order.
+ */
+class RadixHeapScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    RadixHeapScheduler() noexcept;
+
+    /**
+     * Implementation of empty function in EventScheduler.
+     */
+    [[nodiscard]] bool empty() const noexcept override;
+
+    /**
+     * Implementation of front_time function in EventScheduler.
+     */
+    [[nodiscard]] EventTime front_time() const noexcept override;
+
+    /**
+     * Implementation of schedule function in EventScheduler.
+     */
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Implementation of pop function in EventScheduler.
+     */
+    [[nodiscard]] EventList pop() noexcept override;
+
+  private:
+    /**
+     * BucketEntry is a scheduled event with its event time.
+     */
+    struct BucketEntry {
+        /// event time of the event
+        EventTime event_time;
+
+        /// the scheduled event
+        Event event;
+
+        /// next entry in the bucket
+        BucketEntry* next;
+    };
+
+    /**
+     * Bucket is an intrusive FIFO list of pooled BucketEntries.
+     */
+    struct Bucket {
+        /// first entry of the bucket
+        BucketEntry* head = nullptr;
+
+        /// last entry of the bucket
+        BucketEntry* tail = nullptr;
+    };
+
+    /// number of buckets: one per bit of EventTime, plus one for the last popped time
+    static constexpr size_t buckets_count = 8 * sizeof(EventTime) + 1;
+
+    /// buckets of scheduled events
+    std::array<Bucket, buckets_count> buckets;
+
+    /// pool of bucket entries
+    ObjectPool<BucketEntry> entry_pool;
+
+    /// event time of the last popped events
+    EventTime last_time;
+
+    /// number of registered events
+    size_t events_count;
+
+    /**
+     * Compute the bucket index the given event time belongs to.
+     *
+     * @param event_time event time
+     * @return bucket index
+     */
+    [[nodiscard]] size_t bucket_index(EventTime event_time) const noexcept;
+
+    /**
+     * Append an entry to the back of the bucket its event time belongs to.
+     *
+     * @param entry entry to append
+     */
+    void append(BucketEntry* entry) noexcept;
+};
+
+}  // namespace NetworkAnalytical
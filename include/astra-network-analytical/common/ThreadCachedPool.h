@@ -0,0 +1,448 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * PoolStats summarizes the usage of a ThreadCachedPool.
+ * Counters are exact while no other thread is allocating or releasing objects.
+ */
+struct PoolStats {
+    /// number of objects allocated so far
+    uint64_t allocations_count;
+
+    /// number of allocations served by recycled slots, i.e., that a plain allocator would have paid for
+    uint64_t recycled_count;
+
+    /// number of objects currently alive
+    uint64_t live_count;
+
+    /// number of distinct slots ever handed out.
+    /// This is the peak number of live objects if a single thread allocates, and an upper bound of it otherwise.
+    uint64_t peak_live_count;
+
+    /// memory reserved by the pool in bytes
+    uint64_t reserved_bytes;
+};
+
+/**
+ * ThreadCachedPool is a process-wide slab allocator for objects of type T,
+ * meant to back the class-specific operator new and delete of T.
+ *
+ * Each thread allocates from and releases into its own cache of free slots,
+ * so the steady state neither locks nor calls malloc/free.
+ * Caches exchange slots with a shared depot in batches when they run empty or overflow,
+ * so objects may be released by a different thread than the one which allocated them.
+ * Slabs are never returned to the system.
+ *
+ * @tparam T type of the pooled objects
+ * @tparam SlabSize number of objects per slab
+ */
+template <typename T, size_t SlabSize = 1'024> class ThreadCachedPool {
+  public:
+    /**
+     * Allocate uninitialized storage for an object.
+     *
+     * @return pointer to the storage
+     */
+    [[nodiscard]] static void* allocate() noexcept {
+        if (retired()) {
+            // the cache of this thread is gone, take the slow path
+            return depot().allocate();
+        }
+
+        auto& cache = thread_cache();
+        auto& counters = cache.counters;
+        bump(counters.allocations_count);
+
+        if (cache.free_list == nullptr) {
+            // refill the cache from the depot
+            cache.free_count = depot().take_batch(cache.free_list);
+        }
+
+        if (cache.free_list != nullptr) {
+            // recycle a released slot
+            auto* const slot = cache.free_list;
+            cache.free_list = slot->next_free;
+            cache.free_count--;
+            bump(counters.recycled_count);
+            return slot->storage;
+        }
+
+        if (cache.fresh_slot == cache.fresh_end) {
+            // carve a new slab
+            cache.fresh_slot = depot().new_slab();
+            cache.fresh_end = cache.fresh_slot + SlabSize;
+        }
+
+        // hand out a slot never used before
+        bump(counters.fresh_count);
+        return (cache.fresh_slot++)->storage;
+    }
+
+    /**
+     * Release the storage of an object back to the pool.
+     *
+     * @param object pointer to the storage, which must have been allocated by this pool
+     */
+    static void release(void* const object) noexcept {
+        assert(object != nullptr);
+
+        auto* const slot = static_cast<Slot*>(object);
+        if (retired()) {
+            // the cache of this thread is gone, take the slow path
+            depot().release(slot);
+            return;
+        }
+
+        auto& cache = thread_cache();
+        bump(cache.counters.releases_count);
+        slot->next_free = cache.free_list;
+        cache.free_list = slot;
+        cache.free_count++;
+
+        if (cache.free_count > 2 * BatchSize) {
+            // overflowed, hand a batch to the other threads
+            cache.free_count -= depot().give_batch(cache.free_list);
+        }
+    }
+
+    /**
+     * Return every free slot cached by the calling thread to the depot,
+     * e.g., before the thread goes idle while others keep allocating.
+     */
+    static void release_thread_cache() noexcept {
+        if (retired()) {
+            return;
+        }
+
+        auto& cache = thread_cache();
+        depot().give_all(cache.free_list);
+        cache.free_count = 0;
+    }
+
+    /**
+     * Get the usage statistics of the pool, over all threads.
+     *
+     * @return usage statistics
+     */
+    [[nodiscard]] static PoolStats get_stats() noexcept {
+        return depot().get_stats();
+    }
+
+  private:
+    /// number of slots exchanged between a thread cache and the depot at once
+    static constexpr size_t BatchSize = 64;
+
+    /**
+     * Slot holds either an object or a link to the next free slot.
+     */
+    union Slot {
+        /// next free slot, valid only while the slot is free
+        Slot* next_free;
+
+        /// storage of the object
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * Counters of a thread cache.
+     * Only the owning thread writes them; they are atomic so get_stats can read them from any thread.
+     */
+    struct Counters {
+        /// number of allocations
+        std::atomic<uint64_t> allocations_count{0};
+
+        /// number of allocations served by recycled slots
+        std::atomic<uint64_t> recycled_count{0};
+
+        /// number of allocations served by slots never used before
+        std::atomic<uint64_t> fresh_count{0};
+
+        /// number of releases
+        std::atomic<uint64_t> releases_count{0};
+    };
+
+    /**
+     * Cache holds the free slots of a single thread.
+     */
+    struct Cache {
+        /// free slots of the thread
+        Slot* free_list = nullptr;
+
+        /// number of slots in free_list
+        size_t free_count = 0;
+
+        /// next never-used slot of the slab the thread carves from
+        Slot* fresh_slot = nullptr;
+
+        /// end of the slab the thread carves from
+        Slot* fresh_end = nullptr;
+
+        /// usage counters of the thread
+        Counters counters;
+
+        /**
+         * Constructor.
+         */
+        Cache() noexcept {
+            depot().attach(&counters);
+        }
+
+        /**
+         * Destructor.
+         * Hands the free slots and counters of the exiting thread to the depot.
+         */
+        ~Cache() noexcept {
+            depot().give_all(free_list);
+            depot().detach(&counters);
+            retired() = true;
+        }
+    };
+
+    /**
+     * Depot owns the slabs, and the free slots shared by all threads.
+     */
+    class Depot {
+      public:
+        /**
+         * Allocate a new slab.
+         *
+         * @return pointer to the first slot of the slab
+         */
+        [[nodiscard]] Slot* new_slab() noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            slabs.push_back(std::make_unique<Slot[]>(SlabSize));
+            return slabs.back().get();
+        }
+
+        /**
+         * Move up to BatchSize free slots of the depot into an empty list.
+         *
+         * @param list list receiving the slots
+         * @return number of slots moved
+         */
+        [[nodiscard]] size_t take_batch(Slot*& list) noexcept {
+            assert(list == nullptr);
+
+            if (!has_free_slots.load(std::memory_order_relaxed)) {
+                // skip locking while the pool grows
+                return 0;
+            }
+
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            auto taken = size_t{0};
+            while (free_list != nullptr && taken < BatchSize) {
+                auto* const slot = free_list;
+                free_list = slot->next_free;
+                slot->next_free = list;
+                list = slot;
+                taken++;
+            }
+            has_free_slots.store(free_list != nullptr, std::memory_order_relaxed);
+            return taken;
+        }
+
+        /**
+         * Move up to BatchSize slots of a list into the depot.
+         *
+         * @param list list giving the slots
+         * @return number of slots moved
+         */
+        [[nodiscard]] size_t give_batch(Slot*& list) noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            auto given = size_t{0};
+            while (list != nullptr && given < BatchSize) {
+                auto* const slot = list;
+                list = slot->next_free;
+                slot->next_free = free_list;
+                free_list = slot;
+                given++;
+            }
+            has_free_slots.store(free_list != nullptr, std::memory_order_relaxed);
+            return given;
+        }
+
+        /**
+         * Move every slot of a list into the depot.
+         *
+         * @param list list giving the slots
+         */
+        void give_all(Slot*& list) noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            while (list != nullptr) {
+                auto* const slot = list;
+                list = slot->next_free;
+                slot->next_free = free_list;
+                free_list = slot;
+            }
+            has_free_slots.store(free_list != nullptr, std::memory_order_relaxed);
+        }
+
+        /**
+         * Allocate a slot directly from the depot, for threads without a cache.
+         *
+         * @return pointer to the storage
+         */
+        [[nodiscard]] void* allocate() noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            retired_counters.allocations_count++;
+            if (free_list != nullptr) {
+                auto* const slot = free_list;
+                free_list = slot->next_free;
+                has_free_slots.store(free_list != nullptr, std::memory_order_relaxed);
+                retired_counters.recycled_count++;
+                return slot->storage;
+            }
+
+            // a lone slab for the slow path keeps things simple, as it's only hit during thread teardown
+            slabs.push_back(std::make_unique<Slot[]>(1));
+            retired_counters.fresh_count++;
+            lone_slots_count++;
+            return slabs.back()[0].storage;
+        }
+
+        /**
+         * Release a slot directly into the depot, for threads without a cache.
+         *
+         * @param slot slot to release
+         */
+        void release(Slot* const slot) noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            retired_counters.releases_count++;
+            slot->next_free = free_list;
+            free_list = slot;
+            has_free_slots.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * Register the counters of a new thread cache.
+         *
+         * @param counters counters of the cache
+         */
+        void attach(const Counters* const counters) noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            caches_counters.push_back(counters);
+        }
+
+        /**
+         * Fold the counters of an exiting thread cache into the retired counters.
+         *
+         * @param counters counters of the cache
+         */
+        void detach(const Counters* const counters) noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            retired_counters.allocations_count += counters->allocations_count.load(std::memory_order_relaxed);
+            retired_counters.recycled_count += counters->recycled_count.load(std::memory_order_relaxed);
+            retired_counters.fresh_count += counters->fresh_count.load(std::memory_order_relaxed);
+            retired_counters.releases_count += counters->releases_count.load(std::memory_order_relaxed);
+            caches_counters.erase(std::find(caches_counters.begin(), caches_counters.end(), counters));
+        }
+
+        /**
+         * Sum the counters of every thread cache.
+         *
+         * @return usage statistics
+         */
+        [[nodiscard]] PoolStats get_stats() noexcept {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+
+            auto allocations_count = retired_counters.allocations_count;
+            auto recycled_count = retired_counters.recycled_count;
+            auto fresh_count = retired_counters.fresh_count;
+            auto releases_count = retired_counters.releases_count;
+            for (const auto* const counters : caches_counters) {
+                allocations_count += counters->allocations_count.load(std::memory_order_relaxed);
+                recycled_count += counters->recycled_count.load(std::memory_order_relaxed);
+                fresh_count += counters->fresh_count.load(std::memory_order_relaxed);
+                releases_count += counters->releases_count.load(std::memory_order_relaxed);
+            }
+
+            const auto slots_count = (slabs.size() - lone_slots_count) * SlabSize + lone_slots_count;
+            return {allocations_count, recycled_count, allocations_count - releases_count, fresh_count,
+                    slots_count * sizeof(Slot)};
+        }
+
+      private:
+        /// guards every member
+        std::mutex mutex;
+
+        /// allocated slabs
+        std::vector<std::unique_ptr<Slot[]>> slabs;
+
+        /// number of single-slot slabs allocated by the slow path
+        size_t lone_slots_count = 0;
+
+        /// free slots shared by all threads
+        Slot* free_list = nullptr;
+
+        /// whether free_list is non-empty, readable without the lock as a hint
+        std::atomic<bool> has_free_slots{false};
+
+        /// counters of the live thread caches
+        std::vector<const Counters*> caches_counters;
+
+        /// counters of exited threads, and of the slow path
+        struct {
+            uint64_t allocations_count = 0;
+            uint64_t recycled_count = 0;
+            uint64_t fresh_count = 0;
+            uint64_t releases_count = 0;
+        } retired_counters;
+    };
+
+    /**
+     * Get the depot.
+     * The depot is never destructed, so objects can be released during static destruction.
+     *
+     * @return reference to the depot
+     */
+    [[nodiscard]] static Depot& depot() noexcept {
+        static auto* const instance = new Depot();
+        return *instance;
+    }
+
+    /**
+     * Get the cache of the calling thread.
+     *
+     * @return reference to the cache
+     */
+    [[nodiscard]] static Cache& thread_cache() noexcept {
+        static thread_local Cache cache;
+        return cache;
+    }
+
+    /**
+     * Whether the cache of the calling thread has been destructed, i.e., the thread is exiting.
+     *
+     * @return reference to the flag
+     */
+    [[nodiscard]] static bool& retired() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    /**
+     * Increment a counter owned by the calling thread.
+     *
+     * @param counter counter to increment
+     */
+    static void bump(std::atomic<uint64_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,260 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// most detailed trace level compiled in: 0 compiles every trace point out, 1 keeps Info, 2 keeps Debug
+#ifndef ANALYTICAL_TRACE_LEVEL
+#define ANALYTICAL_TRACE_LEVEL 0
+#endif
+
+/// bitmask of the trace categories compiled in, bit i enabling TraceCategory i
+#ifndef ANALYTICAL_TRACE_CATEGORIES
+#define ANALYTICAL_TRACE_CATEGORIES 0xFF
+#endif
+
+/// number of records the trace buffer holds, a power of two
+#ifndef ANALYTICAL_TRACE_BUFFER_SIZE
+#define ANALYTICAL_TRACE_BUFFER_SIZE (1 << 20)
+#endif
+
+namespace NetworkAnalytical {
+
+/**
+ * Components emitting trace records.
+ */
+enum class TraceCategory : uint8_t { Link = 0, Device, Topology };
+
+/**
+ * Verbosity of trace records.
+ */
+enum class TraceLevel : uint8_t { Info = 1, Debug = 2 };
+
+/**
+ * Events recorded by trace points.
+ * Each event belongs to a category, and carries up to four arguments described by TraceEventInfo.
+ */
+enum class TraceEvent : uint16_t {
+    LinkBecameFree = 0,
+    ChunkTransmissionScheduled,
+    ChunkQueued,
+    LinkIdle,
+    LinkReconfigured,
+    LinkReconfigurationSkipped,
+    ChunkRouted,
+    CircuitSchedulesLoaded,
+    ReconfigurationRequested,
+    ReconfigurationDeferred,
+    ReconfigurationIgnored,
+    NetworkDrained,
+    EventsCount,
+};
+
+/**
+ * Get the category of a trace event.
+ *
+ * @param event trace event
+ * @return category the event belongs to
+ */
+constexpr TraceCategory trace_category(const TraceEvent event) noexcept {
+    switch (event) {
+    case TraceEvent::LinkBecameFree:
+    case TraceEvent::ChunkTransmissionScheduled:
+    case TraceEvent::LinkReconfigurationSkipped:
+        return TraceCategory::Link;
+    case TraceEvent::ChunkQueued:
+    case TraceEvent::LinkIdle:
+    case TraceEvent::LinkReconfigured:
+        return TraceCategory::Device;
+    default:
+        return TraceCategory::Topology;
+    }
+}
+
+/**
+ * Check if trace points of an event and level are compiled in.
+ *
+ * @param event trace event
+ * @param level trace level
+ * @return true if the trace point records, false if it compiles to nothing
+ */
+constexpr bool trace_enabled(const TraceEvent event, const TraceLevel level) noexcept {
+    const auto category_bit = 1u << static_cast<unsigned>(trace_category(event));
+    return static_cast<int>(level) <= ANALYTICAL_TRACE_LEVEL && (ANALYTICAL_TRACE_CATEGORIES & category_bit) != 0;
+}
+
+/**
+ * TraceRecord is a fixed-size binary trace record.
+ */
+struct TraceRecord {
+    /// simulation time of the event
+    EventTime time;
+
+    /// arguments of the event, floating-point ones stored bitwise
+    uint64_t args[4];
+
+    /// recorded event
+    TraceEvent event;
+
+    /// trace level of the trace point
+    TraceLevel level;
+
+    /// reserved, keeps records 8-byte aligned
+    uint8_t reserved[5];
+};
+
+static_assert(sizeof(TraceRecord) == 48, "trace records are 48 bytes");
+
+/**
+ * Convert an argument of a trace point to its stored representation.
+ *
+ * @param arg argument of the trace point
+ * @return argument stored in a trace record
+ */
+template <typename T>
+uint64_t to_trace_arg(const T arg) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        const auto value = static_cast<double>(arg);
+        auto bits = uint64_t{0};
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    } else {
+        return static_cast<uint64_t>(static_cast<int64_t>(arg));
+    }
+}
+
+/**
+ * TraceBuffer is a lock-free ring buffer of trace records.
+ *
+ * Trace points from any thread claim a slot with a single atomic increment
+ * and write their record in place. Once the buffer is full, new records overwrite
+ * the oldest ones, so a run keeps its last ANALYTICAL_TRACE_BUFFER_SIZE records.
+ * The buffer is read once trace points are quiescent, e.g., at the end of a run,
+ * and dumped to a binary file decoded offline by decode_trace.
+ */
+class TraceBuffer {
+  public:
+    /**
+     * Get the process-wide trace buffer written by trace points.
+     *
+     * @return trace buffer
+     */
+    static TraceBuffer& get() noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param capacity number of records held, a power of two
+     */
+    explicit TraceBuffer(size_t capacity) noexcept;
+
+    /**
+     * Append a record, overwriting the oldest one if the buffer is full.
+     *
+     * @param record record to append
+     */
+    void record(const TraceRecord& record) noexcept;
+
+    /**
+     * Get the records held, oldest first.
+     *
+     * @return records held by the buffer
+     */
+    [[nodiscard]] std::vector<TraceRecord> snapshot() const noexcept;
+
+    /**
+     * Get the number of records appended since the buffer was cleared.
+     *
+     * @return number of records appended
+     */
+    [[nodiscard]] uint64_t get_records_count() const noexcept;
+
+    /**
+     * Get the number of records overwritten since the buffer was cleared.
+     *
+     * @return number of records dropped
+     */
+    [[nodiscard]] uint64_t get_dropped_count() const noexcept;
+
+    /**
+     * Drop every record.
+     */
+    void clear() noexcept;
+
+    /**
+     * Write the records held to a binary trace file.
+     *
+     * @param path path of the trace file
+     * @return true if the file was written, false otherwise
+     */
+    [[nodiscard]] bool dump(const std::string& path) const noexcept;
+
+  private:
+    /// slots of the ring buffer
+    std::vector<TraceRecord> records;
+
+    /// capacity - 1, masking a record index into its slot
+    uint64_t mask;
+
+    /// index of the next record to append
+    std::atomic<uint64_t> next_index;
+};
+
+/**
+ * Record a trace event in the process-wide trace buffer.
+ *
+ * @param event recorded event
+ * @param level trace level of the trace point
+ * @param time simulation time of the event
+ * @param args up to four arguments of the event
+ */
+template <typename... Args>
+void trace(const TraceEvent event, const TraceLevel level, const EventTime time, const Args... args) noexcept {
+    static_assert(sizeof...(Args) <= 4, "trace events carry up to four arguments");
+
+    auto record = TraceRecord{time, {to_trace_arg(args)...}, event, level, {}};
+    TraceBuffer::get().record(record);
+}
+
+/**
+ * Decode a binary trace file into one line of text per record.
+ *
+ * @param input binary trace file written by TraceBuffer::dump
+ * @param output stream to write the decoded records to
+ * @return true if the trace was decoded, false if it's malformed
+ */
+[[nodiscard]] bool decode_trace(std::istream& input, std::ostream& output) noexcept;
+
+}  // namespace NetworkAnalytical
+
+/**
+ * Trace point, e.g., ANALYTICAL_TRACE(Debug, LinkBecameFree, current_time, pending_chunks_count).
+ * Trace points below ANALYTICAL_TRACE_LEVEL or outside ANALYTICAL_TRACE_CATEGORIES
+ * compile to nothing, and their arguments are never evaluated.
+ */
+#if ANALYTICAL_TRACE_LEVEL > 0
+#define ANALYTICAL_TRACE(level, event, time, ...)                                                              \
+    do {                                                                                                       \
+        if constexpr (::NetworkAnalytical::trace_enabled(::NetworkAnalytical::TraceEvent::event,               \
+                                                         ::NetworkAnalytical::TraceLevel::level)) {            \
+            ::NetworkAnalytical::trace(::NetworkAnalytical::TraceEvent::event,                                 \
+                                       ::NetworkAnalytical::TraceLevel::level, (time), ##__VA_ARGS__);         \
+        }                                                                                                      \
+    } while (false)
+#else
+#define ANALYTICAL_TRACE(level, event, time, ...) \
+    do {                                          \
+    } while (false)
+#endif
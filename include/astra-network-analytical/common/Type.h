@@ -33,4 +33,28 @@ using EventTime = uint64_t;
 /// Basic multi-dimensional topology building blocks
 enum class TopologyBuildingBlock { Undefined, Ring, FullyConnected, Switch, Reconfig };
 
+/**
+ * Collective communication patterns among the NPUs of a topology.
+ * The size of a collective is the size of the buffer of each NPU:
+ *   - AllReduce: every NPU reduces its whole buffer with every other NPU
+ *   - ReduceScatter: every NPU ends up with 1/N of the reduced buffer
+ *   - AllGather: every NPU contributes 1/N of the buffer, and ends up with all of it
+ *   - AllToAll: every NPU sends a distinct 1/N of its buffer to every other NPU
+ */
+enum class CollectiveType { AllReduce, ReduceScatter, AllGather, AllToAll };
+
+/**
+ * Algorithms implementing the collectives:
+ *   - Ring: N-1 steps between neighbors in NPU id order (AllToAll sends to the NPU s apart at step s)
+ *   - Direct: every NPU exchanges with every other NPU in a single step
+ *   - HalvingDoubling: log2(N) steps between NPUs whose ids differ by a power of two,
+ *     halving (ReduceScatter) or doubling (AllGather) the exchanged data at each step;
+ *     the number of NPUs must be a power of two
+ *   - Hierarchical: Ring within each network dimension in turn,
+ *     ReduceScatter from the first dimension up and AllGather from the last one down
+ *     (AllToAll exchanges directly within each dimension)
+ * AllReduce runs as a ReduceScatter followed by an AllGather.
+ */
+enum class CollectiveAlgorithm { Ring, Direct, HalvingDoubling, Hierarchical };
+
 }  // namespace NetworkAnalytical
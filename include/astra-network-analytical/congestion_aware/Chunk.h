@@ -5,8 +5,10 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/ThreadCachedPool.h"
 #include "common/Type.h"
 #include "congestion_aware/Type.h"
+#include <cstddef>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -28,6 +30,22 @@ class Chunk {
      */
     static void chunk_arrived_next_device(void* chunk_ptr) noexcept;
 
+    /**
+     * Allocate a chunk from the chunk pool,
+     * so that std::make_unique<Chunk> doesn't call malloc in the steady state.
+     *
+     * @param size size of the chunk object
+     * @return pointer to the storage of the chunk
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * Recycle the storage of a chunk into the chunk pool.
+     *
+     * @param chunk_ptr pointer to the storage of the chunk
+     */
+    static void operator delete(void* chunk_ptr) noexcept;
+
     /**
      * Constructor.
      *
@@ -38,29 +56,79 @@ class Chunk {
      */
     Chunk(ChunkSize chunk_size, Route route, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Constructor sharing an immutable route, e.g., from Topology::cached_route.
+     *
+     * @param chunk_size: size of the chunk
+     * @param route: route of the chunk from its source to destination
+     * @param callback: callback to be invoked when the chunk arrives destination
+     * @param callback_arg: argument of the callback
+     */
+    Chunk(ChunkSize chunk_size,
+          std::shared_ptr<const Route> route,
+          Callback callback,
+          CallbackArg callback_arg) noexcept;
+
+    /**
+     * Set the topology resolving the device ids of the route.
+     * Topology::send stamps the chunk with the topology it's sent through.
+     *
+     * @param topology topology the chunk travels in
+     */
+    void set_topology(const Topology* topology) noexcept;
+
+    /**
+     * Get the topology resolving the device ids of the route.
+     *
+     * @return topology the chunk travels in
+     */
+    [[nodiscard]] const Topology* get_topology() const noexcept;
+
+    /**
+     * Get the index of the current sitting device of the chunk in its route.
+     *
+     * @return hop cursor of the chunk
+     */
+    [[nodiscard]] size_t get_hop() const noexcept;
+
+    /**
+     * Get the id of the current sitting device of the chunk
+     *
+     * @return id of the current device of the chunk
+     */
+    [[nodiscard]] DeviceId current_device_id() const noexcept;
+
+    /**
+     * Get the id of the next destined device of the chunk
+     *
+     * @return id of the next device of the chunk
+     */
+    [[nodiscard]] DeviceId next_device_id() const noexcept;
+
     /**
      * Get the current sitting device of the chunk
      *
      * @return current device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> current_device() const noexcept;
+    [[nodiscard]] Device* current_device() const noexcept;
 
     /**
      * Get the next destined device of the chunk
      *
      * @return next device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> next_device() const noexcept;
+    [[nodiscard]] Device* next_device() const noexcept;
 
     /**
      * Mark the chunk arrived at its next device
-     * i.e., drop the current device from the route
+     * i.e., advance the hop cursor by one device,
+     * along with the chunks of the train it leads
      */
     void mark_arrived_next_device() noexcept;
 
     /**
      * Check if the chunk arrived at its destination
-     * i.e., if the route length is 1 (only destination device left)
+     * i.e., if the hop cursor reached the last device of the route
      *
      * @return true if the chunk arrived at its destination, false otherwise
      */
@@ -74,7 +142,58 @@ class Chunk {
     [[nodiscard]] ChunkSize get_size() const noexcept;
 
     // MT:
-    [[nodiscard]] const Route& get_route() const noexcept { return route; }
+    [[nodiscard]] const Route& get_route() const noexcept { return *route; }
+
+    /**
+     * Check whether a chunk may follow this one in a train,
+     * i.e., whether both have the same size and the same remaining route.
+     *
+     * @param chunk chunk to check
+     * @return true if the chunk may join the train of this chunk, false otherwise
+     */
+    [[nodiscard]] bool can_join_train(const Chunk& chunk) const noexcept;
+
+    /**
+     * Append a chunk, along with the train it leads, at the end of the train led by this chunk.
+     *
+     * @param chunk chunk to append
+     */
+    void append_to_train(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Detach the chunks following this one in its train.
+     *
+     * @return the next chunk of the train, which leads the rest of the train, or nullptr
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> detach_train() noexcept;
+
+    /**
+     * Get the next chunk of the train led by this chunk.
+     *
+     * @return next chunk of the train, or nullptr if none
+     */
+    [[nodiscard]] Chunk* get_train_next() const noexcept;
+
+    /**
+     * Get the number of chunks in the train led by this chunk.
+     *
+     * @return number of chunks, including this one
+     */
+    [[nodiscard]] size_t get_train_length() const noexcept;
+
+    /**
+     * Get the time the chunk is ready to leave its current device.
+     *
+     * @return ready time of the chunk
+     */
+    [[nodiscard]] EventTime get_ready_time() const noexcept;
+
+    /**
+     * Set the time the chunk is ready to leave its current device.
+     *
+     * @param ready_time ready time of the chunk
+     */
+    void set_ready_time(EventTime ready_time) noexcept;
 
     /**
      * Invoke the registered callback
@@ -86,17 +205,41 @@ class Chunk {
     /// size of the chunk
     ChunkSize chunk_size;
 
-    /// route of the chunk to its destination.
-    /// Route has the structure of [current device, next device, ..., dest device]
+    /// route of the chunk from its source to its destination.
+    /// Route has the structure of [src device, ..., dest device]
     /// e.g., if a chunk starts from device 5, then reaches destination 3,
     /// the route would be e.g., [5, 1, 6, 2, 3]
-    Route route;
+    /// Routes are immutable, so chunks between the same pair can share one.
+    std::shared_ptr<const Route> route;
+
+    /// index of the current device of the chunk in the route
+    size_t hop;
+
+    /// topology resolving device ids of the route
+    const Topology* topology;
 
     /// callback to be invoked when the chunk arrives at its destination
     Callback callback;
 
     /// argument of the callback
     CallbackArg callback_arg;
+
+    /// next chunk of the train led by this chunk:
+    /// chunks of a train travel together, served back to back by every link
+    std::unique_ptr<Chunk> train_next;
+
+    /// last chunk of the train led by this chunk, or this chunk if it leads no train
+    Chunk* train_tail;
+
+    /// number of chunks in the train led by this chunk, including itself
+    size_t train_length;
+
+    /// time the chunk is ready to leave its current device,
+    /// which is later than the arrival of the train for chunks following its leader
+    EventTime ready_time;
 };
 
+/// Pool backing every Chunk allocation, see ThreadCachedPool for its usage statistics
+using ChunkPool = ThreadCachedPool<Chunk>;
+
 }  // namespace NetworkAnalyticalCongestionAware
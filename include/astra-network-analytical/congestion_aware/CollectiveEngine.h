@@ -0,0 +1,201 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// id of a collective started by CollectiveEngine
+using CollectiveId = int;
+
+/**
+ * CollectiveEngine runs collectives over all NPUs of a congestion_aware topology.
+ *
+ * A collective is expanded into a dependency DAG of chunk sends:
+ * the sends of an NPU at each step of the algorithm wait until every chunk
+ * it receives at the previous step has arrived.
+ * Sends whose dependencies have resolved are injected into the topology in batches,
+ * one batch per simulation time, so callers neither route nor track individual chunks.
+ *
+ * The engine schedules its events in the simulation context of the topology,
+ * and must outlive them. Collectives run concurrently, sharing the links of the topology.
+ */
+class CollectiveEngine {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to run collectives on
+     */
+    explicit CollectiveEngine(std::shared_ptr<Topology> topology) noexcept;
+
+    /**
+     * Start a collective over all NPUs at the current simulation time.
+     *
+     * @param type collective communication pattern
+     * @param algorithm algorithm implementing the collective
+     * @param size size of the buffer of each NPU
+     * @param callback callback to be invoked when the collective finishes, or nullptr
+     * @param callback_arg argument of the callback
+     * @return id of the collective
+     */
+    CollectiveId run(CollectiveType type,
+                     CollectiveAlgorithm algorithm,
+                     ChunkSize size,
+                     Callback callback = nullptr,
+                     CallbackArg callback_arg = nullptr) noexcept;
+
+    /**
+     * Check if a collective has finished.
+     *
+     * @param collective_id id of the collective
+     * @return true if every chunk of the collective has arrived, false otherwise
+     */
+    [[nodiscard]] bool is_finished(CollectiveId collective_id) const noexcept;
+
+    /**
+     * Get the time a collective started.
+     *
+     * @param collective_id id of the collective
+     * @return start time of the collective
+     */
+    [[nodiscard]] EventTime get_start_time(CollectiveId collective_id) const noexcept;
+
+    /**
+     * Get the time a finished collective completed.
+     *
+     * @param collective_id id of the collective, which must have finished
+     * @return time the last chunk of the collective arrived
+     */
+    [[nodiscard]] EventTime get_finish_time(CollectiveId collective_id) const noexcept;
+
+    /**
+     * Get the number of chunks sent by a collective.
+     *
+     * @param collective_id id of the collective
+     * @return number of chunks of the collective
+     */
+    [[nodiscard]] size_t get_chunks_count(CollectiveId collective_id) const noexcept;
+
+  private:
+    struct Collective;
+
+    /**
+     * Send is a chunk transmission of a collective, a node of its dependency DAG.
+     */
+    struct Send {
+        /// collective the send belongs to
+        Collective* collective;
+
+        /// src NPU id
+        DeviceId src;
+
+        /// dest NPU id
+        DeviceId dest;
+
+        /// size of the chunk
+        ChunkSize size;
+
+        /// index of the barrier released when the chunk arrives, or -1 if none
+        int barrier;
+    };
+
+    /**
+     * Barrier holds the sends of an NPU at a step until the chunks it receives at the previous step arrive.
+     */
+    struct Barrier {
+        /// number of chunks yet to arrive
+        int pending_arrivals_count;
+
+        /// index of the sends waiting for the barrier
+        std::vector<size_t> sends;
+    };
+
+    /**
+     * Collective holds the dependency DAG of a collective and its progress.
+     */
+    struct Collective {
+        /// engine running the collective
+        CollectiveEngine* engine;
+
+        /// sends of the collective, their addresses are stable once the collective starts
+        std::vector<Send> sends;
+
+        /// barriers between the steps of the collective
+        std::vector<Barrier> barriers;
+
+        /// number of chunks of the collective
+        size_t chunks_count;
+
+        /// number of chunks yet to arrive
+        size_t pending_chunks_count;
+
+        /// time the collective started
+        EventTime start_time;
+
+        /// time the last chunk arrived
+        EventTime finish_time;
+
+        /// callback to be invoked when the collective finishes
+        Callback callback;
+
+        /// argument of the callback
+        CallbackArg callback_arg;
+    };
+
+    /// topology the collectives run on
+    std::shared_ptr<Topology> topology;
+
+    /// collectives started so far, indexed by their id
+    std::vector<std::unique_ptr<Collective>> collectives;
+
+    /// sends whose dependencies have resolved, injected at the next batch
+    std::vector<Send*> ready_sends;
+
+    /// whether a batch injection is scheduled
+    bool injection_scheduled;
+
+    /**
+     * Build the dependency DAG of a collective.
+     *
+     * @param collective collective to build the DAG of
+     * @param type collective communication pattern
+     * @param algorithm algorithm implementing the collective
+     * @param size size of the buffer of each NPU
+     */
+    void build(Collective& collective, CollectiveType type, CollectiveAlgorithm algorithm, ChunkSize size)
+        const noexcept;
+
+    /**
+     * Queue a send for the next batch injection.
+     *
+     * @param send send whose dependencies have resolved
+     */
+    void make_ready(Send* send) noexcept;
+
+    /**
+     * Callback to be invoked to inject the sends that became ready.
+     *
+     * @param engine_ptr pointer to the engine
+     */
+    static void inject_ready_sends(void* engine_ptr) noexcept;
+
+    /**
+     * Callback to be invoked when a chunk of a collective arrives at its destination.
+     *
+     * @param send_ptr pointer to the send of the chunk
+     */
+    static void chunk_arrived(void* send_ptr) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -5,10 +5,15 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/LinkTelemetry.h"
 #include "common/Type.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Link.h"
 #include "congestion_aware/Type.h"
-#include <map>
+#include <cstddef>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -24,8 +29,16 @@ class Device {
      * Constructor.
      *
      * @param id id of the device
+     * @param context simulation context the device belongs to
      */
-    explicit Device(DeviceId id) noexcept;
+    Device(DeviceId id, SimulationContext* context) noexcept;
+
+    /**
+     * Move the device, along with its links, to another simulation context.
+     *
+     * @param context simulation context the device belongs to
+     */
+    void set_context(SimulationContext* context) noexcept;
 
     /**
      * Get id of the device.
@@ -43,29 +56,83 @@ class Device {
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
     /**
-     * Connect a device to another device.
+     * Attach the outgoing links of the device.
+     * Links are owned by the topology, which stores the links of all devices contiguously.
      *
-     * @param id id of the device to connect this device to
-     * @param bandwidth bandwidth of the link
-     * @param latency latency of the link
+     * @param link_dests ids of the devices the links lead to, in increasing order
+     * @param links links, in the same order as link_dests
+     * @param links_count number of outgoing links
      */
-    void connect(DeviceId id, Bandwidth bandwidth, Latency latency) noexcept;
+    void set_links(const DeviceId* link_dests, Link* links, size_t links_count) noexcept;
 
-  private:
-    /// device Id
-    DeviceId device_id;
+    /**
+     * Connect the device to every other device in [0, devices_count) with identical links.
+     * Each link is materialized when the first chunk is sent through it,
+     * so memory grows with the links a workload uses rather than with devices_count.
+     *
+     * @param devices_count number of devices to connect to, including this device
+     * @param bandwidth bandwidth of the links
+     * @param latency latency of the links
+     */
+    void connect_all(int devices_count, Bandwidth bandwidth, Latency latency) noexcept;
+
+    /**
+     * Get the number of links materialized by connect_all so far.
+     *
+     * @return number of materialized links
+     */
+    [[nodiscard]] size_t get_materialized_links_count() const noexcept;
 
-    /// links to other nodes
-    /// map[dest node node_id] -> link
-    std::map<DeviceId, std::shared_ptr<Link>> links;
+    /**
+     * Get the smallest latency among the outgoing links of the device.
+     *
+     * @return smallest link latency, or -1 if the device has no link
+     */
+    [[nodiscard]] Latency get_min_link_latency() const noexcept;
 
     /**
-     * Check if this device is connected to another device.
+     * Append the telemetry of the outgoing links of the device which collected any,
+     * ordered by the id of the device they lead to.
      *
-     * @param dest id of the device to check te connectivity
-     * @return true if connected to the given device, false otherwise
+     * @param entries telemetry of links to append to
      */
-    [[nodiscard]] bool connected(DeviceId dest) const noexcept;
+    void collect_link_telemetry(std::vector<LinkTelemetryEntry>& entries) const noexcept;
+
+    /**
+     * Find the link to another device, materializing it if connected by connect_all.
+     *
+     * @param dest id of the device the link leads to
+     * @return pointer to the link, or nullptr if not connected to the given device
+     */
+    [[nodiscard]] Link* find_link(DeviceId dest) noexcept;
+
+  private:
+    /// device Id
+    DeviceId device_id;
+
+    /// simulation context the device belongs to
+    SimulationContext* context;
+
+    /// ids of the devices the outgoing links lead to, in increasing order
+    const DeviceId* link_dests;
+
+    /// outgoing links, links[i] leads to link_dests[i]
+    Link* links;
+
+    /// number of outgoing links
+    size_t links_count;
+
+    /// devices in [0, implicit_dests_count) other than this device are connected by connect_all
+    int implicit_dests_count;
+
+    /// bandwidth of the links connected by connect_all
+    Bandwidth implicit_bandwidth;
+
+    /// latency of the links connected by connect_all
+    Latency implicit_latency;
+
+    /// links connected by connect_all which have been materialized, keyed by the device they lead to
+    std::unordered_map<DeviceId, Link> implicit_links;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
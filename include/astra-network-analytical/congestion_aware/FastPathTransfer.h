@@ -0,0 +1,82 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Type.h"
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * FastPathTransfer collapses the hops of a chunk over idle links into a single event,
+ * under the FastPath link model.
+ *
+ * When a chunk is sent, the longest prefix of its remaining route whose links are free
+ * by the time the chunk reaches them is reserved at once, and the chunk is scheduled
+ * to arrive at the end of that prefix. Reservations of hops the chunk hasn't reached yet
+ * are tentative: a chunk reaching one of these links earlier would go first in per-hop
+ * simulation, so the transfer is revoked. Its chunk then falls back to per-hop simulation
+ * from the first hop it hasn't started, reaching that hop exactly when per-hop simulation would.
+ *
+ * A transfer stays within a single event queue: transfers aren't used
+ * when a chunk arrival handler (e.g., ParallelSimulator) takes over the delivery of chunks.
+ */
+class FastPathTransfer {
+  public:
+    /**
+     * Send a chunk from its current device,
+     * collapsing the idle prefix of its route if it spans more than one hop.
+     *
+     * @param chunk chunk to send
+     * @param link link from the current device of the chunk to its next device
+     * @param context simulation context the chunk is sent in
+     */
+    static void send(std::unique_ptr<Chunk> chunk, Link* link, SimulationContext* context) noexcept;
+
+    /**
+     * Revoke the transfer, as another chunk reached a link it reserved ahead of time.
+     * The reservations of hops not started yet are cancelled,
+     * and the chunk is scheduled to reach the first of them as in per-hop simulation.
+     */
+    void revoke() noexcept;
+
+  private:
+    /// the transferred chunk, or nullptr once revoked
+    std::unique_ptr<Chunk> chunk;
+
+    /// simulation context the transfer runs in
+    SimulationContext* context;
+
+    /// reserved link of each hop
+    std::vector<Link*> links;
+
+    /// time the chunk starts on the link of each hop
+    std::vector<EventTime> start_times;
+
+    /**
+     * Constructor.
+     *
+     * @param chunk the transferred chunk
+     * @param context simulation context the transfer runs in
+     */
+    FastPathTransfer(std::unique_ptr<Chunk> chunk, SimulationContext* context) noexcept;
+
+    /**
+     * Callback to be invoked when the chunk of a transfer reaches the end of the collapsed hops.
+     *
+     * @param transfer_ptr pointer to the transfer, deleted by the callback
+     */
+    static void transfer_arrived(void* transfer_ptr) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,171 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/Topology.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * FlowSimulator runs a congestion_aware topology at flow level (fluid model),
+ * trading a little fidelity for orders-of-magnitude fewer events than per-hop simulation.
+ *
+ * Each chunk becomes a flow streaming over every link of its route at once.
+ * Flows share links under max-min fairness, and rates are only recomputed
+ * when flows start or finish, so a transfer costs a few events regardless of
+ * its size and route length.
+ *
+ * A flow finishes transmitting once its bytes are drained at the rates it was given,
+ * then reaches its destination after the sum of the latencies of its links.
+ * Serialization isn't repeated at every hop as in the packet-level Link model:
+ * an uncongested h-hop chunk takes (size / bandwidth) + (sum of latencies)
+ * rather than h * (size / bandwidth + latency).
+ *
+ * The simulator schedules its events in the simulation context of the topology,
+ * and must outlive them. Chunk callbacks may send new chunks through the simulator.
+ */
+class FlowSimulator {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology to simulate
+     */
+    explicit FlowSimulator(std::shared_ptr<Topology> topology) noexcept;
+
+    /**
+     * Initiate a transmission of a chunk as a flow along its route.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Get the number of flows being transmitted.
+     *
+     * @return number of active flows
+     */
+    [[nodiscard]] size_t get_active_flows_count() const noexcept;
+
+    /**
+     * Get the number of times flow rates have been recomputed.
+     *
+     * @return number of rate updates
+     */
+    [[nodiscard]] uint64_t get_rate_updates_count() const noexcept;
+
+  private:
+    /**
+     * Flow is a chunk streaming over the links of its route.
+     */
+    struct Flow {
+        /// the transmitted chunk
+        std::unique_ptr<Chunk> chunk;
+
+        /// index of each link of the route in link_states
+        std::vector<size_t> links;
+
+        /// bytes left to transmit
+        double remaining_bytes;
+
+        /// transmission rate in B/ns, or -1 while being computed
+        double rate;
+
+        /// time from the last byte leaving the source to reaching the destination
+        EventTime latency;
+    };
+
+    /**
+     * LinkState holds the capacity of a link crossed by flows.
+     */
+    struct LinkState {
+        /// bandwidth of the link in B/ns
+        double capacity;
+
+        /// capacity not yet given to flows, while computing rates
+        double residual_capacity;
+
+        /// number of flows crossing the link whose rate isn't computed yet
+        int unfrozen_flows_count;
+    };
+
+    /// simulated topology
+    std::shared_ptr<Topology> topology;
+
+    /// flows being transmitted
+    std::vector<Flow> flows;
+
+    /// flows sent since the last update, admitted at the next update
+    std::vector<std::unique_ptr<Chunk>> new_chunks;
+
+    /// state of every link crossed by a flow so far
+    std::vector<LinkState> link_states;
+
+    /// index in link_states of every link crossed by a flow so far
+    std::unordered_map<const Link*, size_t> link_indices;
+
+    /// time flows were last advanced to
+    EventTime last_update_time;
+
+    /// time of the earliest update scheduled, or max EventTime if none
+    EventTime next_update_time;
+
+    /// number of times flow rates have been recomputed
+    uint64_t rate_updates_count;
+
+    /**
+     * Callback to be invoked when flows start or may have finished.
+     *
+     * @param simulator_ptr pointer to the simulator
+     */
+    static void update(void* simulator_ptr) noexcept;
+
+    /**
+     * Callback to be invoked when a flow reaches its destination.
+     *
+     * @param chunk_ptr pointer to the chunk of the flow
+     */
+    static void flow_arrived_dest(void* chunk_ptr) noexcept;
+
+    /**
+     * Advance flows to the current time, admit new flows, retire finished flows,
+     * recompute rates if flows changed, and schedule the next update.
+     */
+    void update() noexcept;
+
+    /**
+     * Turn a chunk into a flow over the links of its route.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void admit(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Recompute the rate of every flow under max-min fairness, by progressive filling:
+     * the link offering the smallest fair share bottlenecks its flows at that share,
+     * which are then removed along with the capacity they use, until every flow has a rate.
+     */
+    void update_rates() noexcept;
+
+    /**
+     * Schedule an update at the given time, unless one is already scheduled by then.
+     *
+     * @param event_time time of the update
+     */
+    void schedule_update(EventTime event_time) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
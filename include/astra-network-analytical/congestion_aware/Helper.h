@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/NetworkParser.h"
+#include "congestion_aware/SimulationContext.h"
 #include "congestion_aware/Topology.h"
 #include <memory>
 
@@ -17,8 +18,10 @@ namespace NetworkAnalyticalCongestionAware {
  * Construct a topology from a NetworkParser.
  *
  * @param network_parser NetworkParser to parse the network input file
+ * @param context simulation context to run the topology in, or nullptr for the default context
  * @return pointer to the constructed topology
  */
-[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser) noexcept;
+[[nodiscard]] std::shared_ptr<Topology> construct_topology(const NetworkParser& network_parser,
+                                                           std::shared_ptr<SimulationContext> context = nullptr) noexcept;
 
 }  // namespace NetworkAnalyticalCongestionAware
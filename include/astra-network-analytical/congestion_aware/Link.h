@@ -5,10 +5,14 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include "common/EventQueue.h"
+#include "common/LinkTelemetry.h"
 #include "common/Type.h"
+#include "congestion_aware/SimulationContext.h"
 #include "congestion_aware/Type.h"
+#include <cstddef>
+#include <list>
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -19,6 +23,8 @@ namespace NetworkAnalyticalCongestionAware {
  */
 class Link {
   public:
+    friend class FastPathTransfer;
+
     /**
      * Callback to be called when a link becomes free.
      *  - If the link has pending chunks, process the first one.
@@ -29,29 +35,65 @@ class Link {
     static void link_become_free(void* link_ptr) noexcept;
 
     /**
-     * Set the event queue to be used by the link.
+     * Constructor.
      *
-     * @param event_queue_ptr pointer to the event queue
+     * @param bandwidth bandwidth of the link
+     * @param latency latency of the link
+     * @param context simulation context the link belongs to
      */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
+    Link(Bandwidth bandwidth, Latency latency, SimulationContext* context) noexcept;
 
     /**
-     * Constructor.
+     * Move the link to another simulation context.
      *
-     * @param bandwidth bandwidth of the link
-     * @param latency latency of the link
+     * @param context simulation context the link belongs to
      */
-    Link(Bandwidth bandwidth, Latency latency) noexcept;
+    void set_context(SimulationContext* context) noexcept;
 
     /**
      * Try to send a chunk through the link.
      * - If the link is free, service the chunk immediately.
-     * - If the link is busy, add the chunk to the pending chunks list.
+     * - If the link is busy, add the chunk to the pending chunks list,
+     *   or reserve the link after the chunks sent before under the Reservation link model.
      *
      * @param chunk the chunk to be served by the link
      */
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
+    /**
+     * Check whether a chunk reaching the link at the given time would start right away,
+     * under the FastPath link model.
+     *
+     * @param time time the chunk reaches the link, not earlier than the current time
+     * @return true if the link is free at the given time, false otherwise
+     */
+    [[nodiscard]] bool is_free_at(EventTime time) noexcept;
+
+    /**
+     * Reserve the link ahead of time for a hop of a fast path transfer.
+     * The link must be free at the start time.
+     *
+     * @param transfer transfer the hop belongs to
+     * @param hop index of the hop in the transfer
+     * @param start_time time the chunk of the transfer reaches the link
+     * @param chunk_size size of the chunk of the transfer
+     * @return time the chunk arrives at the next device
+     */
+    EventTime reserve(FastPathTransfer* transfer, size_t hop, EventTime start_time, ChunkSize chunk_size) noexcept;
+
+    /**
+     * Cancel the reservation of a fast path transfer, if any.
+     *
+     * @param transfer transfer whose reservation to cancel
+     */
+    void release(const FastPathTransfer* transfer) noexcept;
+
+    /**
+     * Commit the reservations starting no later than the current time,
+     * which can't be overtaken by chunks sent afterward.
+     */
+    void commit_reservations() noexcept;
+
     /**
      * Dequeue and try to send the first pending chunk
      * in the pending chunks list.
@@ -75,9 +117,32 @@ class Link {
      */
     void set_free() noexcept;
 
+    /**
+     * Get the bandwidth of the link.
+     *
+     * @return bandwidth of the link in GB/s
+     */
+    [[nodiscard]] Bandwidth get_bandwidth() const noexcept;
+
+    /**
+     * Get the latency of the link.
+     *
+     * @return latency of the link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
+    /**
+     * Get the telemetry collected by the link, if link telemetry is enabled.
+     * The queue depth is only tracked under the EventDriven link model,
+     * where chunks wait in the pending chunks list.
+     *
+     * @return pointer to the telemetry of the link, nullptr if the link collected none
+     */
+    [[nodiscard]] const LinkTelemetry* get_telemetry() const noexcept;
+
   private:
-    /// event queue Link uses to schedule events
-    static std::shared_ptr<EventQueue> event_queue;
+    /// simulation context Link uses to schedule events
+    SimulationContext* context;
 
     /// bandwidth of the link in GB/s
     Bandwidth bandwidth;
@@ -94,6 +159,68 @@ class Link {
     /// flag to indicate if the link is busy
     bool busy;
 
+    /// time the link finishes serializing every chunk reserved so far, under the Reservation link model,
+    /// excluding reservations ahead of time
+    EventTime next_free_time;
+
+    /**
+     * Reservation of the link ahead of time by a hop of a fast path transfer.
+     */
+    struct FastPathReservation {
+        /// transfer the hop belongs to
+        FastPathTransfer* transfer;
+
+        /// index of the hop in the transfer
+        size_t hop;
+
+        /// time the chunk of the transfer starts on the link
+        EventTime start_time;
+
+        /// time the link finishes serializing the chunk of the transfer
+        EventTime end_time;
+
+        /// size of the chunk of the transfer
+        ChunkSize chunk_size;
+    };
+
+    /// reservations ahead of time, ordered by start time, usually a handful
+    /// (a vector keeps Link nothrow-movable, unlike a deque)
+    std::vector<FastPathReservation> fast_path_reservations;
+
+    /// telemetry of the link, created once a chunk is sent if link telemetry is enabled
+    std::unique_ptr<LinkTelemetry> telemetry;
+
+    /**
+     * Get the telemetry to record to.
+     *
+     * @return pointer to the telemetry of the link, nullptr if link telemetry is disabled
+     */
+    [[nodiscard]] LinkTelemetry* telemetry_to_record() noexcept;
+
+    /**
+     * Record chunks added to the pending chunks list, if link telemetry is enabled.
+     *
+     * @param chunks_count number of chunks added
+     */
+    void record_queued_chunks(size_t chunks_count) noexcept;
+
+    /**
+     * Record chunks removed from the pending chunks list, if link telemetry is enabled.
+     *
+     * @param chunks_count number of chunks removed
+     */
+    void record_dequeued_chunks(size_t chunks_count) noexcept;
+
+    /**
+     * Record the hop of a chunk over the link to the Chrome trace, if any.
+     *
+     * @param chunk chunk crossing the link
+     * @param hop index in the route of the chunk of the device the link leaves from
+     * @param ready_time time the chunk reached the link
+     * @param start_time time the link started serializing the chunk
+     */
+    void trace_hop(const Chunk& chunk, size_t hop, EventTime ready_time, EventTime start_time) const noexcept;
+
     /**
      * Compute the serialization delay of a chunk on the link.
      * i.e., serialization delay = (chunk size) / (link bandwidth)
@@ -121,6 +248,35 @@ class Link {
      * @param chunk chunk to be transmitted
      */
     void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Schedule the transmission of a train led by the given chunk.
+     * - Chunks are serialized back to back, each no earlier than it's ready.
+     * - The train arrives next node as a whole, unless the next node is the destination,
+     *   where each chunk arrives on its own.
+     *
+     * @param chunk chunk leading the train
+     * @return time the link finishes serializing the train
+     */
+    [[nodiscard]] EventTime schedule_train_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Reserve the link for the transmission of a chunk, in FIFO order.
+     * - Transmission starts once the link finished serializing the chunks reserved before.
+     * - Chunk arrives next node after the communication delay from the start.
+     * No event is scheduled for the link to become free.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void reserve_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Get the time the link finishes serializing every chunk reserved so far,
+     * including reservations ahead of time.
+     *
+     * @return time the link becomes free
+     */
+    [[nodiscard]] EventTime reserved_free_time() const noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
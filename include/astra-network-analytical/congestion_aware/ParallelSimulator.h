@@ -0,0 +1,259 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Topology.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ParallelSimulator runs a congestion_aware topology as a conservative
+ * parallel discrete-event simulation (PDES).
+ *
+ * Devices are split into contiguous partitions of device ids, one per worker thread,
+ * and each partition runs in its own SimulationContext and EventQueue.
+ * A link belongs to the partition of its
+ * source device, so link events never leave their partition; chunk arrivals are the
+ * only interaction between devices, and are exchanged as messages.
+ *
+ * Partitions are synchronized with fixed windows: a chunk needs at least the minimum
+ * link latency (the lookahead) to reach its next device, so every partition can process
+ * events in [T, T + lookahead) independently, where T is the earliest pending event time
+ * over all partitions. Arrivals are delivered at the window boundary.
+ *
+ * Chunk arrivals at the same time and device are ordered by
+ * (send time, source device id, per-device send order) rather than by the global
+ * scheduling order the sequential EventQueue uses, so that results never depend on
+ * the number of threads. The two orders agree except when chunks whose transmissions
+ * started at the same time on different devices arrive at a device at the same time
+ * and contend for the same outgoing link.
+ *
+ * If the topology has a zero-latency link there is no lookahead,
+ * and the simulation falls back to a single partition driven sequentially.
+ *
+ * Chunk callbacks are invoked on the worker thread owning the destination device,
+ * concurrently with other partitions: they must be thread-safe, and may only send
+ * new chunks from devices of the same partition. Use current_time() in callbacks
+ * to read the simulation time.
+ *
+ * While the simulator exists, devices run in the contexts of their partitions
+ * instead of the context of the topology.
+ */
+class ParallelSimulator {
+  public:
+    /**
+     * Get the simulation time of the partition running on the calling thread.
+     *
+     * @return current simulation time
+     */
+    [[nodiscard]] static EventTime current_time() noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param topology topology to simulate
+     * @param threads_count number of worker threads, capped by the number of devices
+     */
+    ParallelSimulator(std::shared_ptr<Topology> topology, int threads_count) noexcept;
+
+    /**
+     * Destructor.
+     * Devices are moved back to the simulation context of the topology.
+     */
+    ~ParallelSimulator() noexcept;
+
+    /**
+     * Initiate a transmission of a chunk before running the simulation.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Run the simulation until every event is processed.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the time of the last processed event over all partitions.
+     *
+     * @return simulation finish time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the number of partitions the devices are split into.
+     *
+     * @return number of partitions
+     */
+    [[nodiscard]] int get_partitions_count() const noexcept;
+
+    /**
+     * Get the lookahead used to size synchronization windows.
+     *
+     * @return lookahead in ns, 0 if the simulation runs sequentially
+     */
+    [[nodiscard]] EventTime get_lookahead() const noexcept;
+
+    /**
+     * Get the partition a device belongs to.
+     *
+     * @param device_id id of the device
+     * @return partition index of the device
+     */
+    [[nodiscard]] int partition_of(DeviceId device_id) const noexcept;
+
+  private:
+    /**
+     * Message carries a chunk to the partition of its next device.
+     */
+    struct Message {
+        /// time the chunk arrives at its next device
+        EventTime arrival_time;
+
+        /// time the transmission of the chunk started
+        EventTime send_time;
+
+        /// device the chunk was sent from
+        DeviceId source_id;
+
+        /// send order of the chunk among the chunks sent from source_id
+        uint64_t sequence;
+
+        /// the transmitted chunk, owned by the message
+        Chunk* chunk;
+    };
+
+    /**
+     * Partition holds the state of a group of devices driven by a single thread.
+     */
+    struct Partition {
+        /// index of the partition
+        int index;
+
+        /// simulation context the devices of the partition run in
+        std::shared_ptr<SimulationContext> context;
+
+        /// event queue of the partition
+        std::shared_ptr<EventQueue> event_queue;
+
+        /// messages sent from this partition, per destination partition
+        std::vector<std::vector<Message>> outboxes;
+
+        /// scratch space to sort received messages, kept to avoid reallocation
+        std::vector<Message> inbox;
+
+        /// earliest pending event time, or max EventTime if none
+        EventTime next_event_time;
+    };
+
+    /**
+     * Barrier synchronizes the worker threads between simulation phases.
+     * The last thread to arrive runs the completion step before releasing the others.
+     */
+    class Barrier {
+      public:
+        /**
+         * Constructor.
+         *
+         * @param threads_count number of threads to synchronize
+         */
+        explicit Barrier(int threads_count) noexcept;
+
+        /**
+         * Block until every thread has arrived.
+         *
+         * @param completion step run by the last arriving thread
+         * @param simulator argument of the completion step
+         */
+        void arrive_and_wait(void (*completion)(ParallelSimulator*), ParallelSimulator* simulator) noexcept;
+
+      private:
+        /// number of threads to synchronize
+        int threads_count;
+
+        /// number of threads arrived in the current phase
+        int arrived_count;
+
+        /// incremented each time the barrier is released
+        uint64_t generation;
+
+        /// lock protecting the counters
+        std::mutex mutex;
+
+        /// condition the waiting threads block on
+        std::condition_variable released;
+    };
+
+    /// partition driven by the calling thread
+    static thread_local Partition* current_partition;
+
+    /// simulated topology
+    std::shared_ptr<Topology> topology;
+
+    /// minimum time for a chunk to reach its next device
+    EventTime lookahead;
+
+    /// partitions of the devices
+    std::vector<Partition> partitions;
+
+    /// number of chunks sent from each device so far
+    std::vector<uint64_t> sends_count;
+
+    /// upper bound (exclusive) of the current window
+    EventTime window_end;
+
+    /// whether every partition has run out of events
+    bool done;
+
+    /**
+     * Chunk arrival handler buffering a chunk as a message to the partition of its next device.
+     *
+     * @param simulator_ptr pointer to the simulator
+     * @param send_time time the transmission of the chunk started
+     * @param arrival_time time the chunk arrives at the next device
+     * @param chunk the transmitted chunk
+     */
+    static void post_chunk(void* simulator_ptr,
+                           EventTime send_time,
+                           EventTime arrival_time,
+                           std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Barrier completion step computing the next window.
+     *
+     * @param simulator the simulator
+     */
+    static void advance_window(ParallelSimulator* simulator) noexcept;
+
+    /**
+     * Schedule the messages sent to a partition into its event queue.
+     *
+     * @param partition destination partition
+     */
+    void deliver(Partition& partition) noexcept;
+
+    /**
+     * Drive a partition window by window until the simulation is done.
+     *
+     * @param partition partition to drive
+     * @param barrier barrier shared by the worker threads
+     */
+    void run_partition(Partition& partition, Barrier& barrier) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
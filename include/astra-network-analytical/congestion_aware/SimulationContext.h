@@ -0,0 +1,215 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/ChromeTraceWriter.h"
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <cstddef>
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkModel selects how links serve the chunks sent through them, in FIFO order:
+ *   - EventDriven: a link schedules an event when it becomes free,
+ *     which starts the transmission of its next pending chunk
+ *   - Reservation: a link keeps the time it becomes free, and computes the start time
+ *     of a chunk when it's sent, so only chunk arrivals are scheduled as events
+ *   - FastPath: Reservation, and a chunk crossing idle links reserves them all at once
+ *     and is scheduled as a single arrival, see FastPathTransfer
+ * All models produce the same transmission times.
+ */
+enum class LinkModel { EventDriven, Reservation, FastPath };
+
+/**
+ * SimulationContext holds the per-simulation state shared by the components of a topology:
+ * the event queue driving the simulation, and the hooks the components report to.
+ *
+ * Each Topology owns a context, and its Devices and Links refer to it,
+ * so independent simulations can run side by side in a single process.
+ */
+class SimulationContext {
+  public:
+    /**
+     * Handler which takes over the delivery of a chunk to its next device,
+     * instead of the link scheduling the arrival on the event queue.
+     *
+     * @param handler_arg argument registered with the handler
+     * @param send_time time the transmission of the chunk started
+     * @param arrival_time time the chunk arrives at the next device
+     * @param chunk the transmitted chunk
+     */
+    using ChunkArrivalHandler = void (*)(void* handler_arg,
+                                         EventTime send_time,
+                                         EventTime arrival_time,
+                                         std::unique_ptr<Chunk> chunk);
+
+    /**
+     * Get the context used by topologies that aren't given their own context.
+     * Its event queue is set through Topology::set_event_queue.
+     *
+     * @return pointer to the default context
+     */
+    [[nodiscard]] static std::shared_ptr<SimulationContext> default_context() noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param event_queue event queue driving the simulation
+     */
+    explicit SimulationContext(std::shared_ptr<EventQueue> event_queue = nullptr) noexcept;
+
+    /**
+     * Set the event queue driving the simulation.
+     *
+     * @param event_queue pointer to the event queue
+     */
+    void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
+
+    /**
+     * Get the event queue driving the simulation.
+     *
+     * @return pointer to the event queue
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue> get_event_queue() const noexcept;
+
+    /**
+     * Get the current time of the event queue.
+     *
+     * @return current event time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Schedule an event on the event queue.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Set the model links use to serve chunks.
+     * Must be set before any chunk is sent in the context.
+     *
+     * @param link_model link model
+     */
+    void set_link_model(LinkModel link_model) noexcept;
+
+    /**
+     * Get the model links use to serve chunks.
+     *
+     * @return link model
+     */
+    [[nodiscard]] LinkModel get_link_model() const noexcept;
+
+    /**
+     * Set the handler delivering chunks to their next device.
+     * If nullptr (default), chunk arrivals are scheduled on the event queue.
+     *
+     * @param handler chunk arrival handler
+     * @param handler_arg argument passed to the handler
+     */
+    void set_chunk_arrival_handler(ChunkArrivalHandler handler, void* handler_arg) noexcept;
+
+    /**
+     * Set the maximum number of chunks coalesced into a train.
+     * Under the EventDriven link model, chunks with the same size and route waiting back to back
+     * for a link travel as a train: a link serves the whole train with a single link free event,
+     * and the train reaches each intermediate device with a single arrival event.
+     * Chunks of a train keep their own start and arrival times, which match per-chunk simulation
+     * unless other chunks reach a link while a train is still arriving there:
+     * these then wait for the whole train instead of slipping between its chunks.
+     * Must be set before any chunk is sent in the context.
+     *
+     * @param max_train_length maximum number of chunks in a train, 1 (default) disables trains
+     */
+    void set_max_train_length(size_t max_train_length) noexcept;
+
+    /**
+     * Get the maximum number of chunks coalesced into a train.
+     *
+     * @return maximum number of chunks in a train
+     */
+    [[nodiscard]] size_t get_max_train_length() const noexcept;
+
+    /**
+     * Enable or disable link telemetry.
+     * When enabled, each link counts the bytes it transmits, its busy time,
+     * the depth of its pending chunks and the time chunks wait for it, see LinkTelemetry.
+     * Must be set before any chunk is sent in the context.
+     *
+     * @param enabled true to collect link telemetry, false (default) otherwise
+     */
+    void set_link_telemetry_enabled(bool enabled) noexcept;
+
+    /**
+     * Check whether links collect telemetry.
+     *
+     * @return true if link telemetry is enabled, false otherwise
+     */
+    [[nodiscard]] bool is_link_telemetry_enabled() const noexcept;
+
+    /**
+     * Set the writer links record the hops of chunks to, as a Chrome trace.
+     * Must be set before any chunk is sent in the context.
+     *
+     * @param chrome_trace_writer trace writer, nullptr (default) to record nothing
+     */
+    void set_chrome_trace_writer(std::shared_ptr<ChromeTraceWriter> chrome_trace_writer) noexcept;
+
+    /**
+     * Get the writer links record the hops of chunks to.
+     *
+     * @return pointer to the trace writer, nullptr if hops aren't recorded
+     */
+    [[nodiscard]] const std::shared_ptr<ChromeTraceWriter>& get_chrome_trace_writer() const noexcept;
+
+    /**
+     * Check whether a handler takes over the delivery of chunks.
+     *
+     * @return true if a chunk arrival handler is set, false otherwise
+     */
+    [[nodiscard]] bool has_chunk_arrival_handler() const noexcept;
+
+    /**
+     * Deliver a transmitted chunk to its next device at the given arrival time.
+     *
+     * @param send_time time the transmission of the chunk started
+     * @param arrival_time time the chunk arrives at the next device
+     * @param chunk the transmitted chunk
+     */
+    void deliver_chunk(EventTime send_time, EventTime arrival_time, std::unique_ptr<Chunk> chunk) noexcept;
+
+  private:
+    /// event queue driving the simulation
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// model links use to serve chunks
+    LinkModel link_model;
+
+    /// maximum number of chunks coalesced into a train
+    size_t max_train_length;
+
+    /// whether links collect telemetry
+    bool link_telemetry_enabled;
+
+    /// writer links record the hops of chunks to
+    std::shared_ptr<ChromeTraceWriter> chrome_trace_writer;
+
+    /// handler delivering chunks to their next device
+    ChunkArrivalHandler chunk_arrival_handler;
+
+    /// argument passed to chunk_arrival_handler
+    void* chunk_arrival_handler_arg;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
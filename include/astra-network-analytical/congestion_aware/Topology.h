@@ -6,9 +6,15 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventQueue.h"
+#include "common/LinkTelemetry.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -21,7 +27,8 @@ namespace NetworkAnalyticalCongestionAware {
 class Topology {
   public:
     /**
-     * Set the event queue to be used by the topology.
+     * Set the event queue of the default simulation context,
+     * used by topologies not given their own context.
      *
      * @param event_queue pointer to the event queue
      */
@@ -29,12 +36,42 @@ class Topology {
 
     /**
      * Constructor.
+     * The topology starts in the default simulation context.
      */
     Topology() noexcept;
 
+    /**
+     * Destructor.
+     */
+    virtual ~Topology() noexcept;
+
+    /**
+     * Move the topology, along with all its devices and links, to a simulation context.
+     *
+     * @param context simulation context to run the topology in
+     */
+    void set_context(std::shared_ptr<SimulationContext> context) noexcept;
+
+    /**
+     * Get the simulation context of the topology.
+     *
+     * @return pointer to the simulation context
+     */
+    [[nodiscard]] std::shared_ptr<SimulationContext> get_context() const noexcept;
+
+    /**
+     * Move a single device, along with its links, to a simulation context.
+     * Used to drive groups of devices with separate event queues,
+     * the caller keeps the given context alive while the device uses it.
+     *
+     * @param device_id id of the device
+     * @param context simulation context to run the device in
+     */
+    void set_device_context(DeviceId device_id, SimulationContext* context) noexcept;
+
     /**
      * Construct the route from src to dest.
-     * Route is a list of devices (pointers) that the chunk should traverse,
+     * Route is a sequence of device ids that the chunk should traverse,
      * including the src and dest devices themselves.
      *
      * e.g., route(0, 3) = [0, 5, 7, 2, 3]
@@ -46,6 +83,27 @@ class Topology {
      */
     [[nodiscard]] virtual Route route(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Get the route from src to dest, built once and shared by every chunk between the same pair.
+     * Topologies of up to max_npus_for_all_pairs_routes NPUs build the routes of all pairs at first use,
+     * larger ones memoize each route as it's requested.
+     * Safe to call concurrently.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     *
+     * @return immutable route from src NPU to dest NPU
+     */
+    [[nodiscard]] std::shared_ptr<const Route> cached_route(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Get a device of the topology.
+     *
+     * @param device_id id of the device
+     * @return pointer to the device
+     */
+    [[nodiscard]] Device* get_device(DeviceId device_id) const noexcept;
+
     /**
      * Initiate a transmission of a chunk.
      *
@@ -90,7 +148,27 @@ class Topology {
      */
     [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
 
+    /**
+     * Get the smallest latency among all links in the topology.
+     *
+     * @return smallest link latency, or -1 if the topology has no link
+     */
+    [[nodiscard]] Latency get_min_link_latency() const noexcept;
+
+    /**
+     * Get the telemetry of every link which collected any, keyed by (src, dest) device ids
+     * and ordered by them. Links collect telemetry once enabled in the simulation context,
+     * see SimulationContext::set_link_telemetry_enabled, and the result can be written
+     * with write_link_telemetry_csv or write_link_telemetry_json at the end of a run.
+     *
+     * @return telemetry of the links
+     */
+    [[nodiscard]] std::vector<LinkTelemetryEntry> get_link_telemetry() const noexcept;
+
   protected:
+    /// simulation context the topology runs in
+    std::shared_ptr<SimulationContext> context;
+
     /// number of total devices in the topology
     /// device includes non-NPU devices such as switches
     int devices_count;
@@ -108,9 +186,35 @@ class Topology {
     /// holds the entire device instances in the topology
     std::vector<std::shared_ptr<Device>> devices;
 
+    /// links of all devices in compressed sparse row (CSR) layout:
+    /// the outgoing links of device i are links[link_offsets[i]] ... links[link_offsets[i + 1] - 1],
+    /// ordered by the id of the device they lead to
+    std::vector<Link> links;
+
+    /// id of the device each link in links leads to
+    std::vector<DeviceId> link_dests;
+
+    /// offset of the first outgoing link of each device in links, followed by the number of links
+    std::vector<size_t> link_offsets;
+
     /// bandwidth per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// largest number of NPUs for which routes of all pairs are built at once
+    static constexpr int max_npus_for_all_pairs_routes = 128;
+
+    /// guards the construction of all_pairs_routes
+    mutable std::once_flag all_pairs_routes_built;
+
+    /// routes of all pairs, indexed by src * npus_count + dest
+    mutable std::vector<std::shared_ptr<const Route>> all_pairs_routes;
+
+    /// guards memoized_routes
+    mutable std::mutex memoized_routes_mutex;
+
+    /// routes memoized on request, keyed by (src << 32 | dest)
+    mutable std::unordered_map<uint64_t, std::shared_ptr<const Route>> memoized_routes;
+
     /**
      * Instantiate Device objects in the topology.
      */
@@ -118,7 +222,7 @@ class Topology {
 
     /**
      * Connect src -> dest with the given bandwidth and latency.
-     * (i.e., a `Link` gets constructed between the two npus)
+     * (i.e., a `Link` gets constructed between the two npus by build_links)
      *
      * if bidirectional=true, dest -> src connection is also established.
      *
@@ -129,6 +233,43 @@ class Topology {
      * @param bidirectional true if connection is bidirectional, false otherwise
      */
     void connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
+
+    /**
+     * Connect every pair of distinct devices with the given bandwidth and latency.
+     * Links are materialized on first use instead of being constructed by build_links,
+     * so memory grows with the pairs a workload exercises rather than quadratically.
+     *
+     * @param bandwidth bandwidth of links
+     * @param latency latency of links
+     */
+    void connect_all_pairs(Bandwidth bandwidth, Latency latency) noexcept;
+
+    /**
+     * Construct the links of every connection into the CSR layout, and attach them to devices.
+     * Must be called once, after the last connect().
+     */
+    void build_links() noexcept;
+
+  private:
+    /**
+     * Connection requested through connect(), waiting for build_links().
+     */
+    struct Connection {
+        /// src device id
+        DeviceId src;
+
+        /// dest device id
+        DeviceId dest;
+
+        /// bandwidth of link
+        Bandwidth bandwidth;
+
+        /// latency of link
+        Latency latency;
+    };
+
+    /// connections to be constructed by build_links()
+    std::vector<Connection> connections;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -5,8 +5,8 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include <list>
-#include <memory>
+#include "common/Type.h"
+#include <vector>
 
 namespace NetworkAnalyticalCongestionAware {
 
@@ -14,8 +14,10 @@ namespace NetworkAnalyticalCongestionAware {
 class Chunk;
 class Link;
 class Device;
+class Topology;
+class FastPathTransfer;
 
-/// Route is a list of devices
-using Route = std::list<std::shared_ptr<Device>>;
+/// Route is a sequence of device ids, resolved to devices by the topology
+using Route = std::vector<NetworkAnalytical::DeviceId>;
 
 }  // namespace NetworkAnalyticalCongestionAware
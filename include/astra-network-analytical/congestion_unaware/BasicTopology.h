@@ -7,11 +7,14 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/Topology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionUnaware {
 
+template <typename... BasicTopologies> class StaticMultiDimTopology;
+
 /**
  * BasicTopology defines 1D topology
  * such as Ring, FullyConnected, and Switch topology,
@@ -38,6 +41,14 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_within_dim method of Topology.
+     */
+    [[nodiscard]] EventTime send_within_dim(int dim,
+                                            DeviceId src,
+                                            DeviceId dest,
+                                            ChunkSize chunk_size) const noexcept override;
+
     /**
      * Return the type of the basic topology
      * as a TopologyBuildingBlock enum class element.
@@ -56,10 +67,39 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] virtual int compute_hops_count(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Compute the number of hops between each pair of src and dest NPUs.
+     * Implementations are written as branch-free loops the compiler can vectorize.
+     *
+     * @param srcs src NPU ID of each pair
+     * @param dests dest NPU ID of each pair
+     * @param hops_counts filled with the number of hops between each pair
+     * @param pairs_count number of pairs
+     */
+    virtual void compute_hops_counts(const DeviceId* srcs,
+                                     const DeviceId* dests,
+                                     int* hops_counts,
+                                     size_t pairs_count) const noexcept = 0;
+
+    /**
+     * Implement the send_batch_range method of Topology.
+     */
+    void send_batch_range(const DeviceId* srcs,
+                          const DeviceId* dests,
+                          const ChunkSize* chunk_sizes,
+                          EventTime* delays,
+                          size_t chunks_count) const noexcept override;
+
     /// type of the basic topology
     TopologyBuildingBlock basic_topology_type;
 
   private:
+    /// StaticMultiDimTopology calls the kernels of its dimensions directly, so that they are inlined
+    template <typename... BasicTopologies> friend class StaticMultiDimTopology;
+
+    /// number of chunks whose hops counts are computed at once in send_batch_range
+    static constexpr size_t batch_block_size = 1024;
+
     /**
      * Analytically compute the communication delay.
      *
@@ -79,4 +119,21 @@ class BasicTopology : public Topology {
     Latency latency;
 };
 
+// defined inline, for StaticMultiDimTopology to inline the whole send
+inline EventTime BasicTopology::compute_communication_delay(const int hops_count,
+                                                             const ChunkSize chunk_size) const noexcept {
+    assert(hops_count > 0);
+    assert(chunk_size > 0);
+
+    // compute link delay and serialization delay
+    auto link_delay = hops_count * latency;
+    auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+
+    // comms_delay is the summation of the two
+    auto comms_delay = link_delay + serialization_delay;
+
+    // return EventTime type of comms_delay
+    return static_cast<EventTime>(comms_delay);
+}
+
 }  // namespace NetworkAnalyticalCongestionUnaware
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
@@ -36,10 +37,30 @@ class FullyConnected final : public BasicTopology {
     FullyConnected(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
   private:
+    /// calls compute_hops_count directly
+    template <typename... BasicTopologies> friend class StaticMultiDimTopology;
+
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
     [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t pairs_count) const noexcept override;
 };
 
+inline int FullyConnected::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // for FullyConnected, hops_count is always 1 (src -> dest)
+    return 1;
+}
+
 }  // namespace NetworkAnalyticalCongestionUnaware
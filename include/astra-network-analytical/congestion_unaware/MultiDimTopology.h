@@ -5,10 +5,12 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/FastDivider.h"
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
 #include "congestion_unaware/Topology.h"
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -30,6 +32,14 @@ class MultiDimTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_within_dim method of Topology.
+     */
+    [[nodiscard]] EventTime send_within_dim(int dim,
+                                            DeviceId src,
+                                            DeviceId dest,
+                                            ChunkSize chunk_size) const noexcept override;
+
     /**
      * Add a dimension to the multi-dimensional topology.
      *
@@ -38,33 +48,14 @@ class MultiDimTopology : public Topology {
     void append_dimension(std::unique_ptr<BasicTopology> basic_topology) noexcept;
 
   private:
-    /// Each NPU ID can be broken down into multiple dimensions.
-    /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
-    /// then the NPU ID can be broken down into [1, 7, 1].
-    using MultiDimAddress = std::vector<DeviceId>;
-
     /// BasicTopology instances per dimension.
     std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
 
-    /**
-     * Translate the NPU ID into a multi-dimensional address.
-     *
-     * @param npu_id id of the NPU
-     * @return the same NPU in multi-dimensional address representation
-     */
-    [[nodiscard]] MultiDimAddress translate_address(DeviceId npu_id) const noexcept;
-
-    /**
-     * Given src and dest address in multi-dimensional form,
-     * return the dimension where the transfer should happen.
-     * i.e., the dimension where the src and dest addresses differ.
-     *
-     * @param src_address src NPU ID in multi-dimensional form
-     * @param dest_address dest NPU ID in multi-dimensional form
-     * @return the dimension where the transfer should happen
-     */
-    [[nodiscard]] int get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept;
+    /// Divider by the number of NPUs of each dimension.
+    /// Each NPU ID can be broken down into multiple dimensions, lowest dimension first.
+    /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
+    /// then the NPU ID can be broken down into [1, 7, 1].
+    std::vector<FastDivider> npus_count_dividers;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
@@ -0,0 +1,221 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/FastDivider.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/Switch.h"
+#include "congestion_unaware/Topology.h"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <type_traits>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * StaticMultiDimTopology implements a multi-dimensional topology
+ * whose building block of each dimension is known at compile time,
+ * e.g., StaticMultiDimTopology<Ring, FullyConnected, Switch>.
+ *
+ * It estimates the same delays as a MultiDimTopology of the same shape, but
+ * holds its dimensions by value and calls their kernels directly:
+ * send() is unrolled over the dimensions and involves no virtual call.
+ *
+ * Common shapes are explicitly instantiated, see the aliases below.
+ *
+ * @tparam BasicTopologies building block of each dimension, lowest dimension first
+ */
+template <typename... BasicTopologies> class StaticMultiDimTopology final : public Topology {
+    static_assert(sizeof...(BasicTopologies) > 0, "at least a dimension is required");
+    static_assert((std::is_base_of_v<BasicTopology, BasicTopologies> && ...), "dimensions must be basic topologies");
+    static_assert((std::is_final_v<BasicTopologies> && ...), "dimensions must be final to be devirtualized");
+
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topologies topology of each dimension, lowest dimension first
+     */
+    explicit StaticMultiDimTopology(const BasicTopologies&... topologies) noexcept;
+
+    /**
+     * Implement the send method of Topology.
+     */
+    [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
+
+  protected:
+    /**
+     * Implement the send_within_dim method of Topology.
+     */
+    [[nodiscard]] EventTime send_within_dim(int dim,
+                                            DeviceId src,
+                                            DeviceId dest,
+                                            ChunkSize chunk_size) const noexcept override;
+
+    /**
+     * Implement the send_batch_range method of Topology.
+     */
+    void send_batch_range(const DeviceId* srcs,
+                          const DeviceId* dests,
+                          const ChunkSize* chunk_sizes,
+                          EventTime* delays,
+                          size_t chunks_count) const noexcept override;
+
+  private:
+    /// topology of each dimension
+    std::tuple<BasicTopologies...> topology_per_dim;
+
+    /// divider by the number of NPUs of each dimension
+    std::array<FastDivider, sizeof...(BasicTopologies)> npus_count_dividers;
+
+    /**
+     * Estimate the time to send a chunk, given what is left of the src and dest addresses
+     * once the dimensions lower than Dim are peeled off, i.e., they agree on the lower dimensions.
+     *
+     * @tparam Dim dimension to check next
+     * @param src_leftover src NPU ID divided by the number of NPUs of the lower dimensions
+     * @param dest_leftover dest NPU ID divided by the number of NPUs of the lower dimensions
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk from src to dest
+     */
+    template <size_t Dim>
+    [[nodiscard]] EventTime send_from_dim(uint32_t src_leftover,
+                                          uint32_t dest_leftover,
+                                          ChunkSize chunk_size) const noexcept;
+
+    /**
+     * Find the topology of a dimension known at runtime, and send a chunk within it.
+     *
+     * @tparam Dim dimension to check next
+     * @param dim dimension to transmit the chunk in, at least Dim
+     * @param src src NPU ID within the dimension
+     * @param dest dest NPU ID within the dimension
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk from src to dest
+     */
+    template <size_t Dim>
+    [[nodiscard]] EventTime send_within_dim_from(int dim,
+                                                 DeviceId src,
+                                                 DeviceId dest,
+                                                 ChunkSize chunk_size) const noexcept;
+};
+
+template <typename... BasicTopologies>
+StaticMultiDimTopology<BasicTopologies...>::StaticMultiDimTopology(const BasicTopologies&... topologies) noexcept
+    : Topology(),
+      topology_per_dim(topologies...),
+      npus_count_dividers{FastDivider(static_cast<uint32_t>(topologies.get_npus_count()))...} {
+    // set topology shape
+    dims_count = sizeof...(BasicTopologies);
+    npus_count_per_dim = {topologies.get_npus_count()...};
+    bandwidth_per_dim = {topologies.get_bandwidth_per_dim()[0]...};
+    npus_count = (topologies.get_npus_count() * ...);
+}
+
+template <typename... BasicTopologies>
+EventTime StaticMultiDimTopology<BasicTopologies...>::send(const DeviceId src,
+                                                           const DeviceId dest,
+                                                           const ChunkSize chunk_size) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    return send_from_dim<0>(static_cast<uint32_t>(src), static_cast<uint32_t>(dest), chunk_size);
+}
+
+template <typename... BasicTopologies>
+EventTime StaticMultiDimTopology<BasicTopologies...>::send_within_dim(const int dim,
+                                                                      const DeviceId src,
+                                                                      const DeviceId dest,
+                                                                      const ChunkSize chunk_size) const noexcept {
+    assert(0 <= dim && dim < dims_count);
+
+    return send_within_dim_from<0>(dim, src, dest, chunk_size);
+}
+
+template <typename... BasicTopologies>
+void StaticMultiDimTopology<BasicTopologies...>::send_batch_range(const DeviceId* const srcs,
+                                                                  const DeviceId* const dests,
+                                                                  const ChunkSize* const chunk_sizes,
+                                                                  EventTime* const delays,
+                                                                  const size_t chunks_count) const noexcept {
+    // send() is final here, so it is inlined into the loop
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        delays[i] = send(srcs[i], dests[i], chunk_sizes[i]);
+    }
+}
+
+template <typename... BasicTopologies>
+template <size_t Dim>
+EventTime StaticMultiDimTopology<BasicTopologies...>::send_from_dim(const uint32_t src_leftover,
+                                                                    const uint32_t dest_leftover,
+                                                                    const ChunkSize chunk_size) const noexcept {
+    if constexpr (Dim == sizeof...(BasicTopologies)) {
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+                  << std::endl;
+        std::exit(-1);
+    } else {
+        // peel the addresses off the dimension
+        const auto& divider = npus_count_dividers[Dim];
+        const auto src_quotient = divider.divide(src_leftover);
+        const auto dest_quotient = divider.divide(dest_leftover);
+        const auto src_local_id = static_cast<DeviceId>(src_leftover - src_quotient * divider.get_divisor());
+        const auto dest_local_id = static_cast<DeviceId>(dest_leftover - dest_quotient * divider.get_divisor());
+
+        // run localized communication in the first dimension where the addresses differ
+        if (src_local_id != dest_local_id) {
+            const auto& topology = std::get<Dim>(topology_per_dim);
+            const auto hops_count = topology.compute_hops_count(src_local_id, dest_local_id);
+            return topology.compute_communication_delay(hops_count, chunk_size);
+        }
+
+        return send_from_dim<Dim + 1>(src_quotient, dest_quotient, chunk_size);
+    }
+}
+
+template <typename... BasicTopologies>
+template <size_t Dim>
+EventTime StaticMultiDimTopology<BasicTopologies...>::send_within_dim_from(const int dim,
+                                                                           const DeviceId src,
+                                                                           const DeviceId dest,
+                                                                           const ChunkSize chunk_size) const noexcept {
+    if constexpr (Dim + 1 < sizeof...(BasicTopologies)) {
+        if (dim != Dim) {
+            return send_within_dim_from<Dim + 1>(dim, src, dest, chunk_size);
+        }
+    }
+
+    return std::get<Dim>(topology_per_dim).send(src, dest, chunk_size);
+}
+
+/// Ring x FullyConnected x Switch, e.g., a scale-up ring within a node,
+/// fully connected nodes within a pod, and switched pods
+using RingFullyConnectedSwitch = StaticMultiDimTopology<Ring, FullyConnected, Switch>;
+
+/// Ring x Switch
+using RingSwitch = StaticMultiDimTopology<Ring, Switch>;
+
+/// FullyConnected x Switch
+using FullyConnectedSwitch = StaticMultiDimTopology<FullyConnected, Switch>;
+
+/// 2D torus
+using RingRing = StaticMultiDimTopology<Ring, Ring>;
+
+// instantiated once, in StaticMultiDimTopology.cpp
+extern template class StaticMultiDimTopology<Ring, FullyConnected, Switch>;
+extern template class StaticMultiDimTopology<Ring, Switch>;
+extern template class StaticMultiDimTopology<FullyConnected, Switch>;
+extern template class StaticMultiDimTopology<Ring, Ring>;
+
+}  // namespace NetworkAnalyticalCongestionUnaware
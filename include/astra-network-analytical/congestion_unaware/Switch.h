@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
@@ -36,10 +37,30 @@ class Switch final : public BasicTopology {
     Switch(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
   private:
+    /// calls compute_hops_count directly
+    template <typename... BasicTopologies> friend class StaticMultiDimTopology;
+
     /**
      * Implements the compute_hops_count method of BasicTopology.
      */
     [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t pairs_count) const noexcept override;
 };
 
+inline int Switch::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(src != dest);
+
+    // for switch, hops_count is always 2 (src -> switch -> dest)
+    return 2;
+}
+
 }  // namespace NetworkAnalyticalCongestionUnaware
@@ -6,6 +6,8 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -33,6 +35,25 @@ class Topology {
      */
     [[nodiscard]] virtual EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept = 0;
 
+    /**
+     * Estimate the time to be taken to transmit each chunk of a batch,
+     * the i-th chunk being of size chunk_sizes[i] and sent from srcs[i] to dests[i].
+     * Gives the same estimates as calling send() for each chunk, without paying for a call per chunk.
+     *
+     * Large batches can be split across multiple threads.
+     *
+     * @param srcs src NPU ID of each chunk
+     * @param dests dest NPU ID of each chunk
+     * @param chunk_sizes size of each chunk
+     * @param delays resized to the batch size, and filled with the time to send each chunk
+     * @param threads_count maximum number of threads to split the batch across, defaults to 1
+     */
+    void send_batch(const std::vector<DeviceId>& srcs,
+                    const std::vector<DeviceId>& dests,
+                    const std::vector<ChunkSize>& chunk_sizes,
+                    std::vector<EventTime>& delays,
+                    int threads_count = 1) const noexcept;
+
     /**
      * Get the number of NPUs in the topology.
      *
@@ -61,6 +82,23 @@ class Topology {
      */
     [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
 
+    /**
+     * Estimate the time to be taken by a collective over all NPUs, in closed form.
+     *
+     * Each step of the algorithm takes as long as its slowest send, and steps run back to back.
+     * A send only depends on the dimension it crosses and on the distance between
+     * the src and dest NPUs within that dimension, so every step is costed
+     * from a handful of sends, regardless of the number of NPUs.
+     *
+     * @param type collective communication pattern
+     * @param algorithm algorithm implementing the collective
+     * @param size size of the buffer of each NPU
+     * @return time to run the collective
+     */
+    [[nodiscard]] EventTime estimate_collective(CollectiveType type,
+                                                CollectiveAlgorithm algorithm,
+                                                ChunkSize size) const noexcept;
+
   protected:
     /// number of NPUs in the topology
     int npus_count;
@@ -73,6 +111,73 @@ class Topology {
 
     /// network bandwidth (GB/s) per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
+
+    /**
+     * Estimate the time to be taken to transmit a chunk within a single dimension.
+     *
+     * @param dim dimension to transmit the chunk in
+     * @param src src NPU ID within the dimension
+     * @param dest dest NPU ID within the dimension
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk from src to dest
+     */
+    [[nodiscard]] virtual EventTime send_within_dim(int dim,
+                                                    DeviceId src,
+                                                    DeviceId dest,
+                                                    ChunkSize chunk_size) const noexcept = 0;
+
+    /**
+     * Estimate the time to be taken to transmit each chunk of a contiguous range of a batch.
+     * Calls send() for each chunk by default.
+     *
+     * @param srcs src NPU ID of each chunk
+     * @param dests dest NPU ID of each chunk
+     * @param chunk_sizes size of each chunk
+     * @param delays filled with the time to send each chunk
+     * @param chunks_count number of chunks in the range
+     */
+    virtual void send_batch_range(const DeviceId* srcs,
+                                  const DeviceId* dests,
+                                  const ChunkSize* chunk_sizes,
+                                  EventTime* delays,
+                                  size_t chunks_count) const noexcept;
+
+  private:
+    /// minimum number of chunks worth handing over to another thread in send_batch
+    static constexpr size_t batch_chunks_per_thread_min = 1 << 16;
+
+    /**
+     * Estimate the time to be taken by a phase of a collective among the NPUs
+     * which differ only in their addresses of dimensions [first_dim, last_dim].
+     *
+     * @param type ReduceScatter, AllGather or AllToAll
+     * @param algorithm Ring, Direct or HalvingDoubling
+     * @param first_dim first dimension spanned by the phase
+     * @param last_dim last dimension spanned by the phase
+     * @param data_size size of the buffer of each NPU in the phase
+     * @return time to run the phase
+     */
+    [[nodiscard]] EventTime estimate_phase(CollectiveType type,
+                                           CollectiveAlgorithm algorithm,
+                                           int first_dim,
+                                           int last_dim,
+                                           ChunkSize data_size) const noexcept;
+
+    /**
+     * Estimate the time to be taken to transmit a chunk to the NPU a given offset apart
+     * among the NPUs spanning dimensions [first_dim, last_dim].
+     * The chunk crosses the lowest dimension where the offset has a nonzero digit.
+     *
+     * @param first_dim first dimension spanned
+     * @param last_dim last dimension spanned
+     * @param offset offset of the dest NPU from the src NPU, wrapping around
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk
+     */
+    [[nodiscard]] EventTime send_to_offset(int first_dim,
+                                           int last_dim,
+                                           uint64_t offset,
+                                           ChunkSize chunk_size) const noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
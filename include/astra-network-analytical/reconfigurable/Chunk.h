@@ -5,8 +5,10 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/ThreadCachedPool.h"
 #include "common/Type.h"
 #include "reconfigurable/Type.h"
+#include <cstddef>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -28,6 +30,22 @@ class Chunk {
      */
     static void chunk_arrived_next_device(void* chunk_ptr) noexcept;
 
+    /**
+     * Allocate a chunk from the chunk pool,
+     * so that std::make_unique<Chunk> doesn't call malloc in the steady state.
+     *
+     * @param size size of the chunk object
+     * @return pointer to the storage of the chunk
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * Recycle the storage of a chunk into the chunk pool.
+     *
+     * @param chunk_ptr pointer to the storage of the chunk
+     */
+    static void operator delete(void* chunk_ptr) noexcept;
+
 
     /**
      * Constructor.
@@ -43,11 +61,12 @@ class Chunk {
         : Chunk(chunk_size, std::move(route), callback, callback_arg, -1) {}
 
     bool no_route() noexcept {
-        return route.size() <= 1;
+        return route.size() - hop <= 1;
     }
 
     void update_route(Route new_route, int topology_iteration) noexcept {
         route = std::move(new_route);
+        hop = 0;
         this->topology_iteration = topology_iteration;
     }
 
@@ -55,29 +74,60 @@ class Chunk {
         return topology_iteration;
     }
 
+    /**
+     * Set the topology resolving the device ids of the route.
+     * Topology::send stamps the chunk with the topology it's sent through.
+     *
+     * @param topology topology the chunk travels in
+     */
+    void set_topology(const Topology* topology) noexcept;
+
+    /**
+     * Get the id of the current sitting device of the chunk
+     *
+     * @return id of the current device of the chunk
+     */
+    [[nodiscard]] DeviceId current_device_id() const noexcept;
+
+    /**
+     * Get the id of the next destined device of the chunk
+     *
+     * @return id of the next device of the chunk
+     */
+    [[nodiscard]] DeviceId next_device_id() const noexcept;
+
     /**
      * Get the current sitting device of the chunk
      *
      * @return current device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> current_device() const noexcept;
+    [[nodiscard]] Device* current_device() const noexcept;
 
     /**
      * Get the next destined device of the chunk
      *
      * @return next device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> next_device() const noexcept;
+    [[nodiscard]] Device* next_device() const noexcept;
+
+    /**
+     * Get the route of the chunk, from the device the route was set at.
+     *
+     * @return route of the chunk
+     */
+    [[nodiscard]] const Route& get_route() const noexcept {
+        return route;
+    }
 
     /**
      * Mark the chunk arrived at its next device
-     * i.e., drop the current device from the route
+     * i.e., advance the hop cursor by one device
      */
     void mark_arrived_next_device() noexcept;
 
     /**
      * Check if the chunk arrived at its destination
-     * i.e., if the route length is 1 (only destination device left)
+     * i.e., if the hop cursor reached the last device of the route
      *
      * @return true if the chunk arrived at its destination, false otherwise
      */
@@ -90,6 +140,20 @@ class Chunk {
      */
     [[nodiscard]] ChunkSize get_size() const noexcept;
 
+    /**
+     * Get the time the chunk reached the link it waits for or crosses.
+     *
+     * @return ready time of the chunk
+     */
+    [[nodiscard]] EventTime get_ready_time() const noexcept;
+
+    /**
+     * Set the time the chunk reached the link it waits for or crosses.
+     *
+     * @param ready_time ready time of the chunk
+     */
+    void set_ready_time(EventTime ready_time) noexcept;
+
     /**
      * Invoke the registered callback
      * i.e., this method should be called when the chunk arrives its destination.
@@ -104,8 +168,6 @@ class Chunk {
         return on_route_chunks;
     }
 
-    Route route;
-
   private:
     static int on_route_chunks;
 
@@ -113,9 +175,16 @@ class Chunk {
     ChunkSize chunk_size;
 
     /// route of the chunk to its destination.
-    /// Route has the structure of [current device, next device, ..., dest device]
+    /// Route has the structure of [src device, ..., dest device]
     /// e.g., if a chunk starts from device 5, then reaches destination 3,
     /// the route would be e.g., [5, 1, 6, 2, 3]
+    Route route;
+
+    /// index of the current device of the chunk in the route
+    size_t hop;
+
+    /// topology resolving device ids of the route
+    const Topology* topology;
 
     DeviceId src_id;
 
@@ -128,6 +197,12 @@ class Chunk {
     CallbackArg callback_arg;
 
     int topology_iteration;
+
+    /// time the chunk reached the link it waits for or crosses
+    EventTime ready_time;
 };
 
+/// Pool backing every Chunk allocation, see ThreadCachedPool for its usage statistics
+using ChunkPool = ThreadCachedPool<Chunk>;
+
 }  // namespace NetworkAnalyticalReconfigurable
@@ -5,10 +5,17 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/LinkTelemetry.h"
 #include "common/Type.h"
+#include "reconfigurable/Link.h"
+#include "reconfigurable/SimulationContext.h"
 #include "reconfigurable/Type.h"
-#include <map>
+#include <cstddef>
+#include <deque>
+#include <list>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <queue>
 #include <functional>
 #include <link.h>
@@ -29,12 +36,10 @@ class Device : public std::enable_shared_from_this<Device> {
      * Constructor.
      *
      * @param id id of the device
+     * @param context simulation context the device runs in
      */
-    explicit Device(DeviceId id) noexcept;
+    Device(DeviceId id, SimulationContext* context) noexcept;
 
-    static std::function<void()> increment_callback; // Callback to be invoked when a link becomes free
-
-    static bool drain_all_flow;
     /**
      * Get id of the device.
      *
@@ -53,6 +58,15 @@ class Device : public std::enable_shared_from_this<Device> {
 
     void link_become_free(DeviceId link_id) noexcept;
 
+    /**
+     * Callback to be called when the links reconfigured without being materialized become free.
+     *
+     * @param arg pointer to the device owning the links
+     */
+    static void unmaterialized_links_become_free(void* const arg) noexcept;
+
+    void unmaterialized_links_become_free() noexcept;
+
     /**
      * Initiate a chunk transmission.
      * You must invoke this method on the source device of the chunk.
@@ -62,29 +76,50 @@ class Device : public std::enable_shared_from_this<Device> {
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
     /**
-     * Connect a device to another device.
+     * Connect the device to every device in [0, devices_count), itself included.
+     * Links start with zero bandwidth and latency, and are materialized on first use
+     * or when a reconfiguration changes them.
      *
-     * @param id id of the device to connect this device to
-     * @param bandwidth bandwidth of the link
-     * @param latency latency of the link
+     * @param devices_count number of devices to connect to
      */
-    void connect(DeviceId id, Bandwidth bandwidth, Latency latency) noexcept;
+    void connect_all(int devices_count) noexcept;
 
     void reconfigure(std::vector<Bandwidth> bandwidths,
                      std::vector<Route> routes,
                      std::vector<Latency> latencies,
                      Latency reconfigTime) noexcept;
 
+    int pending_chunks_count(DeviceId id) const noexcept;
+
     /**
-     * Disconnect a device from another device.
+     * Get the link to another device, materializing it if needed.
      *
-     * @param id id of the device to disconnect this device from
+     * @param id id of the device the link leads to
+     * @return pointer to the link
      */
-    void disconnect(DeviceId id) noexcept;
+    Link* get_link(DeviceId id) noexcept;
 
-    int pending_chunks_count(DeviceId id) const noexcept;
+    /**
+     * Count the links to other devices which are not busy, without materializing any link.
+     *
+     * @return number of idle links, excluding the link to the device itself
+     */
+    [[nodiscard]] int idle_links_count() const noexcept;
+
+    /**
+     * Get the number of links materialized so far.
+     *
+     * @return number of materialized links
+     */
+    [[nodiscard]] size_t get_materialized_links_count() const noexcept;
 
-    std::shared_ptr<Link> get_link(DeviceId id) const noexcept;
+    /**
+     * Append the telemetry of the outgoing links of the device which collected any,
+     * ordered by the id of the device they lead to.
+     *
+     * @param entries telemetry of links to append to
+     */
+    void collect_link_telemetry(std::vector<LinkTelemetryEntry>& entries) const noexcept;
 
     bool draining;
 
@@ -94,14 +129,39 @@ class Device : public std::enable_shared_from_this<Device> {
     /// device Id
     DeviceId device_id;
 
+    /// simulation context the device and its links run in
+    SimulationContext* context;
+
     int topology_iteration;
 
-    /// links to other nodes
-    /// map[dest node node_id] -> link
+    /**
+     * Outgoing link along with the chunks waiting for it.
+     */
+    struct Port {
+        Port(Bandwidth bandwidth, Latency latency, SimulationContext* context) noexcept;
+
+        /// outgoing link
+        Link link;
+
+        /// chunks waiting for the link
+        std::list<std::unique_ptr<Chunk>> pending_chunks;
+    };
 
-    std::map<DeviceId, std::shared_ptr<Link>> links;
-    std::map<DeviceId, std::list<std::unique_ptr<Chunk>>> pending_chunks;
-    std::map<DeviceId, Route> routes;
+    /// number of devices connected by connect_all, this device included
+    int devices_count;
+
+    /// materialized outgoing links, keyed by the device they lead to
+    /// links which aren't materialized have zero bandwidth and latency, and are never busy
+    std::unordered_map<DeviceId, Port> ports;
+
+    /// number of materialized links to other devices, excluding the link to this device
+    int materialized_peers_count;
+
+    /// route towards each device, indexed by device id
+    std::vector<Route> routes;
+
+    /// times at which the links left unmaterialized by past reconfigurations become free
+    std::deque<EventTime> unmaterialized_free_times;
 
     /**
      * Check if this device is connected to another device.
@@ -110,6 +170,14 @@ class Device : public std::enable_shared_from_this<Device> {
      * @return true if connected to the given device, false otherwise
      */
     [[nodiscard]] bool connected(DeviceId dest) const noexcept;
+
+    /**
+     * Get the port towards another device, materializing its link on first use.
+     *
+     * @param dest id of the device the link leads to, which must be connected
+     * @return port towards the given device
+     */
+    [[nodiscard]] Port& port(DeviceId dest) noexcept;
 };
 
 }  // namespace NetworkAnalyticalReconfigurable
@@ -6,9 +6,10 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventQueue.h"
+#include "common/LinkTelemetry.h"
 #include "common/Type.h"
+#include "reconfigurable/SimulationContext.h"
 #include "reconfigurable/Type.h"
-#include <functional>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -20,25 +21,14 @@ namespace NetworkAnalyticalReconfigurable {
  */
 class Link {
   public:
-
-    static int num_drained_links;
-
-    static std::function<void()> increment_callback;
-
-    /**
-     * Set the event queue to be used by the link.
-     *
-     * @param event_queue_ptr pointer to the event queue
-     */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
-
     /**
      * Constructor.
      *
      * @param bandwidth bandwidth of the link
      * @param latency latency of the link
+     * @param context simulation context the link runs in
      */
-    Link(Bandwidth bandwidth, Latency latency) noexcept;
+    Link(Bandwidth bandwidth, Latency latency, SimulationContext* context) noexcept;
 
     /**
      * Check if the link is busy.
@@ -71,8 +61,6 @@ class Link {
      */
     unsigned long reconfigure(Bandwidth bandwidth, Latency latency, Latency reconfig_time) noexcept;
 
-    static int get_current_time() noexcept;
-
     /**
      * Get the bandwidth of the link in GB/s.
      *
@@ -82,11 +70,23 @@ class Link {
         return bandwidth;
     }
 
-    static void schedule_event(EventTime event_time, Callback callback, void* const arg) noexcept;
+    /**
+     * Record the number of chunks waiting for the link, if link telemetry is enabled.
+     *
+     * @param queue_depth number of chunks waiting for the link
+     */
+    void record_queue_depth(size_t queue_depth) noexcept;
+
+    /**
+     * Get the telemetry collected by the link, if link telemetry is enabled.
+     *
+     * @return pointer to the telemetry of the link, nullptr if the link collected none
+     */
+    [[nodiscard]] const LinkTelemetry* get_telemetry() const noexcept;
 
   private:
-    /// event queue Link uses to schedule events
-    static std::shared_ptr<EventQueue> event_queue;
+    /// simulation context the link schedules events in
+    SimulationContext* context;
 
     /// bandwidth of the link in GB/s
     Bandwidth bandwidth;
@@ -109,6 +109,16 @@ class Link {
     /// flag to indicate if the link is busy
     bool busy;
 
+    /// telemetry of the link, created once a chunk is sent if link telemetry is enabled
+    std::unique_ptr<LinkTelemetry> telemetry;
+
+    /**
+     * Get the telemetry to record to.
+     *
+     * @return pointer to the telemetry of the link, nullptr if link telemetry is disabled
+     */
+    [[nodiscard]] LinkTelemetry* telemetry_to_record() noexcept;
+
     /**
      * Compute the serialization delay of a chunk on the link.
      * i.e., serialization delay = (chunk size) / (link bandwidth)
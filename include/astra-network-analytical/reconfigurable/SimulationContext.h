@@ -0,0 +1,144 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include <functional>
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalReconfigurable {
+
+/**
+ * SimulationContext holds the per-simulation state shared by the components of a topology:
+ * the event queue driving the simulation, the drain bookkeeping of reconfigurations,
+ * and the callback devices report drained links to.
+ *
+ * Each Topology refers to a context, and so do its Devices and Links,
+ * so independent simulations can run side by side in a single process.
+ */
+class SimulationContext {
+  public:
+    /**
+     * Get the context used by topologies that aren't given their own context.
+     * Its event queue is set through Topology::set_event_queue.
+     *
+     * @return pointer to the default context
+     */
+    [[nodiscard]] static std::shared_ptr<SimulationContext> default_context() noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param event_queue event queue driving the simulation
+     */
+    explicit SimulationContext(std::shared_ptr<EventQueue> event_queue = nullptr) noexcept;
+
+    /**
+     * Set the event queue driving the simulation.
+     *
+     * @param event_queue pointer to the event queue
+     */
+    void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
+
+    /**
+     * Get the event queue driving the simulation.
+     *
+     * @return pointer to the event queue
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue> get_event_queue() const noexcept;
+
+    /**
+     * Get the current time of the event queue.
+     *
+     * @return current event time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Schedule an event on the event queue.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param arg argument of the callback function
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg arg) noexcept;
+
+    /**
+     * Set the callback invoked whenever a link gets drained.
+     *
+     * @param callback callback to invoke
+     */
+    void set_increment_callback(std::function<void()> callback) noexcept;
+
+    /**
+     * Invoke the callback registered for drained links.
+     */
+    void increment_callback() const noexcept;
+
+    /**
+     * Get the number of links drained so far in the ongoing reconfiguration.
+     *
+     * @return number of drained links
+     */
+    [[nodiscard]] int get_num_drained_links() const noexcept;
+
+    /**
+     * Set the number of links drained so far in the ongoing reconfiguration.
+     *
+     * @param num_drained_links number of drained links
+     */
+    void set_num_drained_links(int num_drained_links) noexcept;
+
+    /**
+     * Check whether links report to the increment callback when they are drained.
+     *
+     * @return true if drained links are reported, false otherwise
+     */
+    [[nodiscard]] bool is_drain_all_flow() const noexcept;
+
+    /**
+     * Set whether links report to the increment callback when they are drained.
+     *
+     * @param drain_all_flow true to report drained links, false otherwise
+     */
+    void set_drain_all_flow(bool drain_all_flow) noexcept;
+
+    /**
+     * Enable or disable link telemetry, see LinkTelemetry.
+     * Must be set before any chunk is sent in the context.
+     *
+     * @param enabled true to collect link telemetry, false (default) otherwise
+     */
+    void set_link_telemetry_enabled(bool enabled) noexcept;
+
+    /**
+     * Check whether links collect telemetry.
+     *
+     * @return true if link telemetry is enabled, false otherwise
+     */
+    [[nodiscard]] bool is_link_telemetry_enabled() const noexcept;
+
+  private:
+    /// event queue driving the simulation
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// callback to be invoked when a link gets drained
+    std::function<void()> on_link_drained;
+
+    /// number of links drained so far in the ongoing reconfiguration
+    int num_drained_links;
+
+    /// whether drained links are reported to on_link_drained
+    bool drain_all_flow;
+
+    /// whether links collect telemetry
+    bool link_telemetry_enabled;
+};
+
+}  // namespace NetworkAnalyticalReconfigurable
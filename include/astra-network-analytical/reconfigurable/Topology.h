@@ -6,8 +6,11 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/EventQueue.h"
+#include "common/LinkTelemetry.h"
 #include "reconfigurable/Chunk.h"
 #include "reconfigurable/Device.h"
+#include "reconfigurable/Link.h"
+#include "reconfigurable/SimulationContext.h"
 #include <memory>
 #include <vector>
 
@@ -21,7 +24,8 @@ namespace NetworkAnalyticalReconfigurable {
 class Topology {
   public:
     /**
-     * Set the event queue to be used by the topology.
+     * Set the event queue of the default simulation context,
+     * used by topologies that aren't given their own context.
      *
      * @param event_queue pointer to the event queue
      */
@@ -29,11 +33,32 @@ class Topology {
 
     /**
      * Constructor.
+     *
+     * @param npus_count number of NPUs
+     * @param devices_count number of devices
+     * @param context simulation context the topology runs in
+     */
+    Topology(int npus_count,
+             int devices_count,
+             std::shared_ptr<SimulationContext> context = SimulationContext::default_context()) noexcept;
+
+    /**
+     * Get the simulation context the topology runs in.
+     *
+     * @return pointer to the simulation context
      */
-    Topology(int npus_count, int devices_count) noexcept;
+    [[nodiscard]] std::shared_ptr<SimulationContext> get_context() const noexcept;
 
     std::shared_ptr<Device> get_device(const DeviceId deviceId) noexcept;
 
+    /**
+     * Get a device of the topology without sharing its ownership.
+     *
+     * @param device_id id of the device
+     * @return pointer to the device
+     */
+    [[nodiscard]] Device* get_device_ptr(DeviceId device_id) const noexcept;
+
     /**
      * Initiate a transmission of a chunk.
      *
@@ -57,6 +82,14 @@ class Topology {
      */
     [[nodiscard]] int get_devices_count() const noexcept;
 
+    /**
+     * Get the telemetry of every link which collected any, keyed by (src, dest) device ids
+     * and ordered by them, see SimulationContext::set_link_telemetry_enabled.
+     *
+     * @return telemetry of the links
+     */
+    [[nodiscard]] std::vector<LinkTelemetryEntry> get_link_telemetry() const noexcept;
+
   protected:
     /// number of total devices in the topology
     /// device includes non-NPU devices such as switches
@@ -71,24 +104,13 @@ class Topology {
 
     std::vector<std::shared_ptr<Device>> devices;
 
+    /// simulation context the devices run in
+    std::shared_ptr<SimulationContext> context;
 
     /**
      * Instantiate Device objects in the topology.
      */
     void instantiate_devices() noexcept;
-    /**
-     * Connect src -> dest with the given bandwidth and latency.
-     * (i.e., a `Link` gets constructed between the two npus)
-     *
-     * if bidirectional=true, dest -> src connection is also established.
-     *
-     * @param src src device id
-     * @param dest dest device id
-     * @param bandwidth bandwidth of link
-     * @param latency latency of link
-     * @param bidirectional true if connection is bidirectional, false otherwise
-     */
-    void connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
 };
 
 }  // namespace NetworkAnalyticalReconfigurable
@@ -8,9 +8,11 @@ LICENSE file in the root directory of this source tree.
 #include "common/EventQueue.h"
 #include "reconfigurable/Chunk.h"
 #include "reconfigurable/Device.h"
+#include "reconfigurable/SimulationContext.h"
 #include "reconfigurable/Topology.h"
 #include "reconfigurable/Type.h"
 #include "reconfigurable/Link.h"
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -25,8 +27,30 @@ class TopologyManager {
   public:
     /**
      * Constructor.
+     *
+     * @param npus_count number of NPUs
+     * @param devices_count number of devices
+     * @param context simulation context the topology runs in
+     * @param circuit_schedules bandwidth matrices to reconfigure to, by topology id
+     */
+    TopologyManager(int npus_count,
+                    int devices_count,
+                    std::shared_ptr<SimulationContext> context,
+                    std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules = {}) noexcept;
+
+    /**
+     * Constructor running the topology in the default simulation context.
+     * The event queue must be the one set through Topology::set_event_queue.
+     *
+     * @param npus_count number of NPUs
+     * @param devices_count number of devices
+     * @param event_queue event queue of the default simulation context
+     * @param circuit_schedules bandwidth matrices to reconfigure to, by topology id
      */
-    TopologyManager(int npus_count, int devices_count, EventQueue* event_queue, std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules) noexcept;
+    TopologyManager(int npus_count,
+                    int devices_count,
+                    EventQueue* event_queue,
+                    std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules = {}) noexcept;
 
     std::shared_ptr<Device> get_device(const DeviceId deviceId) noexcept;
 
@@ -57,7 +81,7 @@ class TopologyManager {
 
     /**
      * Construct the route from src to dest.
-     * Route is a list of devices (pointers) that the chunk should traverse,
+     * Route is a sequence of device ids that the chunk should traverse,
      * including the src and dest devices themselves.
      *
      * e.g., route(0, 3) = [0, 5, 7, 2, 3]
@@ -99,8 +123,8 @@ class TopologyManager {
     /// device includes non-NPU devices such as switches
     int devices_count;
 
-    /// event queue to be used by the topology
-    EventQueue* event_queue;
+    /// simulation context the topology runs in
+    std::shared_ptr<SimulationContext> context;
 
     /// number of NPUs in the topology
     /// NPU excludes non-NPU devices such as switches
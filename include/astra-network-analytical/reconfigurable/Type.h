@@ -5,9 +5,9 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include <list>
-#include <memory>
+#include "common/Type.h"
 #include <optional>
+#include <vector>
 
 namespace NetworkAnalyticalReconfigurable {
 
@@ -15,8 +15,9 @@ namespace NetworkAnalyticalReconfigurable {
 class Chunk;
 class Link;
 class Device;
+class Topology;
 
-/// Route is a list of devices
-using Route = std::list<std::shared_ptr<Device>>;
+/// Route is a sequence of device ids, resolved to devices by the topology
+using Route = std::vector<NetworkAnalytical::DeviceId>;
 
 }  // namespace NetworkAnalyticalReconfigurable
@@ -0,0 +1,117 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_unaware/Topology.h"
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <yaml-cpp/yaml.h>
+
+namespace NetworkAnalytical {
+
+/**
+ * SimulationServer answers queries on topologies kept constructed across requests,
+ * so clients pay for neither process launch nor topology construction per query.
+ *
+ * Requests and responses are JSON objects, one per line, answered in order.
+ * Each response echoes the "id" of its request, if given, and holds either results
+ * or "ok": false with an "error":
+ *   - {"op": "load", "name": N, "backend": "congestion_unaware" | "congestion_aware",
+ *      "network": {network config} | "path": yml file}
+ *     -> {"npus_count": n}: construct a topology and keep it under name N, replacing any previous one
+ *   - {"op": "send", "topology": N, "chunks": [[src, dest, size], ...]}
+ *     -> {"delays": [...], "finish_time": t}: time to deliver each chunk, all sent at once
+ *   - {"op": "collective", "topology": N, "collectives": [{"type": T, "algorithm": A, "size": s}, ...]}
+ *     -> {"times": [...]}: time to run each collective over all NPUs, one at a time
+ *   - {"op": "unload", "name": N}: drop a topology
+ *   - {"op": "quit"}: stop the server
+ * Invalid requests, including invalid network configs, are answered with an error
+ * and leave the loaded topologies untouched.
+ */
+class SimulationServer {
+  public:
+    /**
+     * Answer requests until the input ends or a quit request.
+     *
+     * @param input stream of requests
+     * @param output stream of responses
+     * @return true if a quit request was received, false otherwise
+     */
+    bool serve(std::istream& input, std::ostream& output) noexcept;
+
+    /**
+     * Answer a request.
+     *
+     * @param line request
+     * @param quit set to true if the request is a quit request
+     * @return response
+     */
+    std::string answer(const std::string& line, bool& quit) noexcept;
+
+  private:
+    /**
+     * Topology kept constructed between requests, along with what it needs to run.
+     * congestion_aware topologies keep their own event queue, whose time only moves forward:
+     * each query starts at the current time and reports times relative to it.
+     */
+    struct LoadedTopology {
+        /// whether the topology is congestion_aware
+        bool congestion_aware;
+
+        /// number of NPUs
+        int npus_count;
+
+        /// congestion_unaware topology
+        std::shared_ptr<NetworkAnalyticalCongestionUnaware::Topology> unaware_topology;
+
+        /// event queue driving the congestion_aware topology
+        std::shared_ptr<EventQueue> event_queue;
+
+        /// congestion_aware topology
+        std::shared_ptr<NetworkAnalyticalCongestionAware::Topology> aware_topology;
+    };
+
+    /// topologies kept constructed, by name
+    std::map<std::string, LoadedTopology> topologies;
+
+    /**
+     * Construct a topology.
+     *
+     * @param request load request
+     * @return response fields
+     */
+    std::string load(const YAML::Node& request);
+
+    /**
+     * Find a loaded topology.
+     *
+     * @param request request naming the topology
+     * @return the topology
+     */
+    LoadedTopology& find_topology(const YAML::Node& request);
+
+    /**
+     * Estimate the time to deliver a batch of chunks, all sent at once.
+     *
+     * @param request send request
+     * @return response fields
+     */
+    std::string send(const YAML::Node& request);
+
+    /**
+     * Estimate the time to run a batch of collectives, one at a time.
+     *
+     * @param request collective request
+     * @return response fields
+     */
+    std::string run_collectives(const YAML::Node& request);
+};
+
+}  // namespace NetworkAnalytical
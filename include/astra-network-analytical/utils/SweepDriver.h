@@ -0,0 +1,161 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * Network configuration, holding one value per dimension for each parameter.
+ */
+struct NetworkConfig {
+    /// building block per dimension
+    std::vector<std::string> topology;
+
+    /// number of NPUs per dimension
+    std::vector<int> npus_count;
+
+    /// bandwidth per dimension
+    std::vector<Bandwidth> bandwidth;
+
+    /// latency per dimension
+    std::vector<Latency> latency;
+
+    /// reconfiguration time, for the reconfigurable backend
+    Latency reconfig_time;
+};
+
+/**
+ * Sweep over the network configurations derived from a base configuration,
+ * with a set of values to try for each parameter.
+ *
+ * Configurations are the cartesian product of the values of every parameter,
+ * and are only built when evaluated: the i-th configuration is decoded from i,
+ * the last parameter varying the fastest.
+ */
+struct Sweep {
+    /// backend to evaluate the configurations with
+    std::string backend;
+
+    /// values to try for the building blocks
+    std::vector<std::vector<std::string>> topology_values;
+
+    /// values to try for the number of NPUs
+    std::vector<std::vector<int>> npus_count_values;
+
+    /// values to try for the bandwidth
+    std::vector<std::vector<Bandwidth>> bandwidth_values;
+
+    /// values to try for the latency
+    std::vector<std::vector<Latency>> latency_values;
+
+    /// reconfiguration time of every configuration
+    Latency reconfig_time = 0;
+
+    /// whether the workload is a collective, or else random traffic
+    bool collective_workload = false;
+
+    /// collective to run
+    CollectiveType collective_type = CollectiveType::AllReduce;
+
+    /// algorithm of the collective to run
+    CollectiveAlgorithm collective_algorithm = CollectiveAlgorithm::Ring;
+
+    /// size of the collective or of each chunk of the traffic
+    ChunkSize size = 0;
+
+    /// number of chunks of the traffic
+    uint64_t chunks_count = 0;
+
+    /// seed the traffic of each configuration is derived from
+    uint64_t seed = 0;
+
+    /**
+     * Get the number of configurations.
+     *
+     * @return number of configurations
+     */
+    [[nodiscard]] size_t get_configs_count() const noexcept {
+        return topology_values.size() * npus_count_values.size() * bandwidth_values.size() * latency_values.size();
+    }
+
+    /**
+     * Build a configuration.
+     *
+     * @param config_index index of the configuration
+     * @return the configuration
+     */
+    [[nodiscard]] NetworkConfig get_config(size_t config_index) const noexcept {
+        assert(config_index < get_configs_count());
+
+        auto config = NetworkConfig();
+        config.reconfig_time = reconfig_time;
+        config.latency = latency_values[config_index % latency_values.size()];
+        config_index /= latency_values.size();
+        config.bandwidth = bandwidth_values[config_index % bandwidth_values.size()];
+        config_index /= bandwidth_values.size();
+        config.npus_count = npus_count_values[config_index % npus_count_values.size()];
+        config_index /= npus_count_values.size();
+        config.topology = topology_values[config_index];
+        return config;
+    }
+};
+
+/**
+ * Read and check a sweep file, so that every configuration of the sweep can be evaluated.
+ * Exits on an invalid sweep file.
+ *
+ * The sweep file holds:
+ *   - base: network config the configurations derive from, relative to the sweep file
+ *   - backend: congestion_unaware, congestion_aware, or reconfigurable
+ *   - sweep: values to try for topology, npus_count, bandwidth and latency, each a list per dimension
+ *   - workload: {type: collective, collective: AllReduce, algorithm: Ring, size: 1048576},
+ *     or {type: traffic, chunks_count: 1024, size: 1048576} for chunks between random NPUs
+ *   - seed: seed of the random traffic, defaults to 0
+ *
+ * @param path path of the sweep file
+ * @return the sweep
+ */
+Sweep read_sweep(const std::string& path);
+
+/**
+ * Evaluate a configuration: the time to run the collective,
+ * or to deliver every chunk of the traffic, all sent at once.
+ *
+ * @param sweep sweep the configuration belongs to
+ * @param config_index index of the configuration
+ * @return time to run the workload in ns
+ */
+EventTime evaluate(const Sweep& sweep, size_t config_index) noexcept;
+
+/**
+ * Evaluate every configuration of a sweep across a work-stealing thread pool.
+ * Results only depend on the sweep, whatever the number of threads.
+ *
+ * @param sweep sweep to evaluate
+ * @param threads_count number of threads
+ * @return time to run the workload of each configuration, in sweep order
+ */
+std::vector<EventTime> evaluate_sweep(const Sweep& sweep, int threads_count) noexcept;
+
+/**
+ * Write the results of a sweep as a columnar JSON file:
+ * one array per column, holding one row per configuration in sweep order.
+ *
+ * @param output stream to write to
+ * @param sweep evaluated sweep
+ * @param times time to run the workload of each configuration
+ */
+void write_sweep_results(std::ostream& output, const Sweep& sweep, const std::vector<EventTime>& times) noexcept;
+
+}  // namespace NetworkAnalytical
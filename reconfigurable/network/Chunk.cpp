@@ -5,7 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "reconfigurable/Chunk.h"
 #include "reconfigurable/Device.h"
-#include "reconfigurable/Link.h"
+#include "reconfigurable/Topology.h"
 #include <cassert>
 #include <optional>
 #include <stdio.h>
@@ -30,36 +30,72 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
         chunk->invoke_callback();
     } else {
         // send this chunk to next dest
-        const auto current_node = chunk->current_device();
+        auto* const current_node = chunk->current_device();
         current_node->send(std::move(chunk));  // send chunk to next des
     }
 }
 
+void* Chunk::operator new(const size_t size) {
+    // chunks are never derived, so the pool serves every allocation
+    assert(size == sizeof(Chunk));
+
+    return ChunkPool::allocate();
+}
+
+void Chunk::operator delete(void* const chunk_ptr) noexcept {
+    if (chunk_ptr == nullptr) {
+        return;
+    }
+
+    ChunkPool::release(chunk_ptr);
+}
+
 Chunk::Chunk(const ChunkSize chunk_size, Route route, const Callback callback, const CallbackArg callback_arg, int topology_iteration) noexcept
     : chunk_size(chunk_size),
       route(std::move(route)),
+      hop(0),
+      topology(nullptr),
       callback(callback),
       callback_arg(callback_arg),
-      topology_iteration(topology_iteration) {
+      topology_iteration(topology_iteration),
+      ready_time(0) {
     assert(chunk_size > 0);
     assert(callback != nullptr);
 }
 
-std::shared_ptr<Device> Chunk::current_device() const noexcept {
-    // assert the route is not empty
-    assert(!route.empty());
+void Chunk::set_topology(const Topology* const topology) noexcept {
+    assert(topology != nullptr);
+
+    this->topology = topology;
+}
+
+DeviceId Chunk::current_device_id() const noexcept {
+    assert(hop < route.size());
 
-    // return the first npu in route
-    return route.front();
+    // return the device at the hop cursor
+    return route[hop];
 }
 
-std::shared_ptr<Device> Chunk::next_device() const noexcept {
+DeviceId Chunk::next_device_id() const noexcept {
     // assert the chunk has next dest
     assert(!arrived_dest());
 
     // return next dest
-    const auto next_dest = std::next(route.begin(), 1);
-    return *next_dest;
+    return route[hop + 1];
+}
+
+Device* Chunk::current_device() const noexcept {
+    assert(topology != nullptr);
+
+    // resolve the current device through the topology
+    return topology->get_device_ptr(current_device_id());
+}
+
+Device* Chunk::next_device() const noexcept {
+    assert(topology != nullptr);
+
+    // resolve the next device through the topology
+    return topology->get_device_ptr(next_device_id());
 }
 
 void Chunk::mark_arrived_next_device() noexcept {
@@ -67,15 +103,15 @@ void Chunk::mark_arrived_next_device() noexcept {
     // it means the chunk hasn't arrived its final dest yet
     assert(!arrived_dest());
 
-    // pop previous node from the route
+    // advance the hop cursor
     // marking the current node has been changed
-    route.pop_front();
+    hop++;
 }
 
 bool Chunk::arrived_dest() const noexcept {
-    // if a chunk arrived dest, route length should be 1
-    // i.e., only containing the dest node
-    return route.size() == 1;
+    // if a chunk arrived dest, the hop cursor points to the last device
+    // i.e., only the dest node is left
+    return hop + 1 == route.size();
 }
 
 ChunkSize Chunk::get_size() const noexcept {
@@ -85,6 +121,14 @@ ChunkSize Chunk::get_size() const noexcept {
     return chunk_size;
 }
 
+EventTime Chunk::get_ready_time() const noexcept {
+    return ready_time;
+}
+
+void Chunk::set_ready_time(const EventTime ready_time) noexcept {
+    this->ready_time = ready_time;
+}
+
 void Chunk::invoke_callback() noexcept {
     // invoke callback
     (*callback)(callback_arg);
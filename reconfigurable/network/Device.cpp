@@ -4,30 +4,39 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "reconfigurable/Device.h"
+#include "common/Trace.h"
 #include "reconfigurable/Chunk.h"
 #include "reconfigurable/Link.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <vector>
 
 using namespace NetworkAnalyticalReconfigurable;
 
-std::function<void()> Device::increment_callback = []() { };
-bool Device::drain_all_flow = true;
-
-Device::Device(const DeviceId id) noexcept : device_id(id), topology_iteration(0), reconfiguring(false) {
+Device::Device(const DeviceId id, SimulationContext* const context) noexcept
+    : reconfiguring(false),
+      device_id(id),
+      context(context),
+      topology_iteration(0),
+      devices_count(0),
+      materialized_peers_count(0) {
     assert(id >= 0);
+    assert(context != nullptr);
 }
 
+Device::Port::Port(const Bandwidth bandwidth, const Latency latency, SimulationContext* const context) noexcept
+    : link(bandwidth, latency, context) {}
+
 DeviceId Device::get_id() const noexcept {
     assert(device_id >= 0);
     return device_id;
 }
 
-std::shared_ptr<Link> Device::get_link(const DeviceId id) const noexcept {
+Link* Device::get_link(const DeviceId id) noexcept {
     assert(id >= 0);
     assert(connected(id));
-    return links.at(id);
+    return &port(id).link;
 }
 
 struct LinkFreeCallbackArg {
@@ -38,41 +47,81 @@ struct LinkFreeCallbackArg {
 int Device::pending_chunks_count(const DeviceId id) const noexcept {
     assert(id >= 0);
     assert(connected(id));
-    return static_cast<int>(pending_chunks.at(id).size());
+
+    // links which aren't materialized have never held a chunk
+    const auto it = ports.find(id);
+    if (it == ports.end()) {
+        return 0;
+    }
+
+    return static_cast<int>(it->second.pending_chunks.size());
+}
+
+int Device::idle_links_count() const noexcept {
+    // links which aren't materialized are never busy
+    auto idle_links = devices_count - 1 - materialized_peers_count;
+
+    for (const auto& [id, port] : ports) {
+        if (id != device_id && !port.link.is_busy()) {
+            idle_links++;
+        }
+    }
+
+    return idle_links;
+}
+
+size_t Device::get_materialized_links_count() const noexcept {
+    return ports.size();
+}
+
+void Device::collect_link_telemetry(std::vector<LinkTelemetryEntry>& entries) const noexcept {
+    const auto first_entry = entries.size();
+
+    for (const auto& [dest, device_port] : ports) {
+        if (const auto* const telemetry = device_port.link.get_telemetry(); telemetry != nullptr) {
+            entries.push_back({device_id, dest, *telemetry});
+        }
+    }
+
+    // ports come in hash order
+    std::sort(entries.begin() + first_entry, entries.end(),
+              [](const LinkTelemetryEntry& a, const LinkTelemetryEntry& b) { return a.dest < b.dest; });
 }
 
 void Device::link_become_free(DeviceId link_id) noexcept {
-    
+    auto& free_port = port(link_id);
+    auto& link = free_port.link;
+    auto& pending = free_port.pending_chunks;
+
     // set link free
-    links[link_id]->set_free();
-    // std::cout << "Device " << device_id << ": link to " << link_id << " is free at time " << Link::get_current_time() << std::endl;
+    link.set_free();
 
 
     // process pending chunks if one exist
-    if(pending_chunks[link_id].empty() || pending_chunks[link_id].front()->get_topology_iteration() > topology_iteration) {
-    std::cout << "Device " << device_id << ": link to " << link_id << " is free but no pending chunks or chunk from future topology iteration. Pending queue size: " << pending_chunks[link_id].size() << std::endl;
-        if(drain_all_flow){
-            increment_callback();
+    if(pending.empty() || pending.front()->get_topology_iteration() > topology_iteration) {
+        ANALYTICAL_TRACE(Debug, LinkIdle, context->get_current_time(), device_id, link_id, pending.size());
+        if(context->is_drain_all_flow()){
+            context->increment_callback();
         }
 
         return;
     }
 
     // printf("Pending chunk topology iteration: %d, current topology iteration: %d\n",
-    //        pending_chunks[link_id].front()->get_topology_iteration(), topology_iteration);
+    //        pending.front()->get_topology_iteration(), topology_iteration);
 
-    std::unique_ptr<Chunk> chunk = std::move(pending_chunks[link_id].front());
-    pending_chunks[link_id].pop_front();
+    std::unique_ptr<Chunk> chunk = std::move(pending.front());
+    pending.pop_front();
+    link.record_queue_depth(pending.size());
 
-    auto next_link_free_time = links[link_id]->send(std::move(chunk));
+    auto next_link_free_time = link.send(std::move(chunk));
     // schedule the next link free event
     // create a new callback argument for the next link free event
     LinkFreeCallbackArg* next_callback_arg = new LinkFreeCallbackArg{shared_from_this(), link_id};
     // get the next link free time
-    
-    std::cout << "Device " << device_id << ": link to " << link_id << " becomes free at time and scheduled another chunk " << next_link_free_time << ", link pending chunk: " << pending_chunks[link_id].size() << std::endl;
+    ANALYTICAL_TRACE(Debug, LinkBecameFree, context->get_current_time(), pending.size());
 
-    Link::schedule_event(next_link_free_time, link_become_free, next_callback_arg);
+    context->schedule_event(next_link_free_time, link_become_free, next_callback_arg);
 }
 
 void Device::link_become_free(void* const arg) noexcept {
@@ -91,12 +140,37 @@ void Device::link_become_free(void* const arg) noexcept {
     delete callback_arg;
 }
 
+void Device::unmaterialized_links_become_free() noexcept {
+    assert(!unmaterialized_free_times.empty());
+    unmaterialized_free_times.pop_front();
+
+    // every link still unmaterialized was left idle with no pending chunks,
+    // links materialized since the reconfiguration have scheduled their own event
+    if (context->is_drain_all_flow()) {
+        const auto unmaterialized_peers_count = devices_count - 1 - materialized_peers_count;
+        for (auto i = 0; i < unmaterialized_peers_count; i++) {
+            context->increment_callback();
+        }
+    }
+}
+
+void Device::unmaterialized_links_become_free(void* const arg) noexcept {
+    assert(arg != nullptr);
+    const auto* const callback_arg = static_cast<const LinkFreeCallbackArg*>(arg);
+    assert(callback_arg->device_ptr != nullptr);
+
+    callback_arg->device_ptr->unmaterialized_links_become_free();
+
+    // clean up the callback argument
+    delete callback_arg;
+}
+
 void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     // assert the validity of the chunk
     assert(chunk != nullptr);
 
     // assert this node is the current source of the chunk
-    assert(chunk->current_device()->get_id() == device_id);
+    assert(chunk->current_device_id() == device_id);
 
     // assert the chunk hasn't arrived its final destination yet
     assert(!chunk->arrived_dest());
@@ -109,53 +183,53 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     //     }
     //     std::cout << std::endl;
     // }
-    chunk->update_route(routes[chunk->next_device()->get_id()], chunk->get_topology_iteration());
+    chunk->update_route(routes[chunk->next_device_id()], chunk->get_topology_iteration());
 
     // get next dest
-    const auto next_dest = chunk->next_device();
-    const auto next_dest_id = next_dest->get_id();
+    const auto next_dest_id = chunk->next_device_id();
 
     // assert the next dest is connected to this node
     assert(connected(next_dest_id));
 
-    auto link = links[next_dest_id];
+    auto& next_port = port(next_dest_id);
+    auto& link = next_port.link;
 
-    if (link->is_busy() || link->get_bandwidth() == Bandwidth(0) || chunk->get_topology_iteration() > topology_iteration) {
+    // the chunk reaches the link, whether it waits for it or not
+    chunk->set_ready_time(context->get_current_time());
+
+    if (link.is_busy() || link.get_bandwidth() == Bandwidth(0) || chunk->get_topology_iteration() > topology_iteration) {
         // link is busy, add the chunk to pending chunks
-        pending_chunks[next_dest_id].push_back(std::move(chunk));
-        std::cout << "Device " << device_id << ": link to " << next_dest_id << " is busy or reconfiguring, adding chunk to pending queue. Pending queue size: " << pending_chunks[next_dest_id].size() << std::endl;
+        next_port.pending_chunks.push_back(std::move(chunk));
+        link.record_queue_depth(next_port.pending_chunks.size());
+        ANALYTICAL_TRACE(Debug, ChunkQueued, context->get_current_time(), device_id, next_dest_id,
+                         next_port.pending_chunks.size());
         return;
     }
 
     // send the chunk to the next dest
     // delegate this task to the link
-    auto link_free_time = links[next_dest_id]->send(std::move(chunk));
+    auto link_free_time = link.send(std::move(chunk));
     LinkFreeCallbackArg* args = new LinkFreeCallbackArg{shared_from_this(), next_dest_id};
-    Link::schedule_event(link_free_time, link_become_free, args);
+    context->schedule_event(link_free_time, link_become_free, args);
 }
 
-void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency latency) noexcept {
-    assert(id >= 0);
-    assert(bandwidth >= 0);
-    assert(latency >= 0);
+void Device::connect_all(const int devices_count) noexcept {
+    assert(devices_count > device_id);
 
     // assert there's no existing connection
-    assert(!connected(id));
+    assert(this->devices_count == 0);
 
-    // create link
-    links[id] = std::make_shared<Link>(bandwidth, latency);
-    pending_chunks[id] = std::list<std::unique_ptr<Chunk>>();
+    this->devices_count = devices_count;
+    routes = std::vector<Route>(devices_count);
 }
 
 void Device::reconfigure(std::vector<Bandwidth> bandwidth, std::vector<Route> routes, std::vector<Latency> latency, Latency reconfig_time) noexcept {
-    assert(bandwidth.size() == links.size());
-    assert(latency.size() == links.size());
+    assert(bandwidth.size() == static_cast<size_t>(devices_count));
+    assert(latency.size() == static_cast<size_t>(devices_count));
 
     topology_iteration++;
 
-    for (const auto& [id, link] : links) {
-        assert(id >= 0);
-
+    for (auto id = 0; id < devices_count; id++) {
         if(id == device_id){
             continue;
         }
@@ -163,60 +237,59 @@ void Device::reconfigure(std::vector<Bandwidth> bandwidth, std::vector<Route> ro
         assert(bandwidth[id] >= 0);
         assert(latency[id] >= 0);
         assert(connected(id));
- 
+
         // update the route
         this->routes[id] = routes[id];
+
+        // a link which isn't materialized keeps zero bandwidth and latency:
+        // it stays unmaterialized if left unchanged, and is materialized otherwise
+        if (ports.count(id) == 0 && bandwidth[id] == Bandwidth(0) && latency[id] == Latency(0)) {
+            continue;
+        }
+        auto& reconfigured_port = port(id);
+
         // reconfigure the link
-        printf("Device %d: Reconfiguring link to %d, pending chunk size: %ld, new bandwidth: %f\n", device_id, id, pending_chunks[id].size(), bandwidth[id]);
-        auto free_time = link->reconfigure(bandwidth[id], latency[id], reconfig_time);
+        ANALYTICAL_TRACE(Info, LinkReconfigured, context->get_current_time(), device_id, id, bandwidth[id],
+                         reconfigured_port.pending_chunks.size());
+        auto free_time = reconfigured_port.link.reconfigure(bandwidth[id], latency[id], reconfig_time);
         // create a callback argument for the link free event
 
         LinkFreeCallbackArg* args = new LinkFreeCallbackArg{shared_from_this(), id};
         // schedule the link free event
-        Link::schedule_event(free_time, link_become_free, args);
+        context->schedule_event(free_time, link_become_free, args);
     }
 
-    // std::vector<std::unique_ptr<Chunk>> pending_chunks_copy;
-    // // move pending chunks to a temporary vector
-    // for (auto& [dest_id, queue] : pending_chunks) {
-    //     while (!queue.empty()) {
-    //         std::unique_ptr<Chunk> chunk = std::move(queue.front());
-    //         queue.pop_front();
-    //         if(chunk->get_topology_iteration() > topology_iteration) {
-    //             queue.push_back(std::move(chunk));
-    //         }
-    //         else {
-    //             pending_chunks_copy.push_back(std::move(chunk));
-    //         }
-    //     }
-    // }
-
-    // // re-assign routes for the pending chunks
-    // for (auto& chunk : pending_chunks_copy) {
-    //     assert(chunk != nullptr);
-    //     assert(chunk->current_device()->get_id() == device_id);
+    // links left unmaterialized need no reconfiguration and become free on the next tick, all at once
+    const auto free_time = context->get_current_time() + 1;
+    unmaterialized_free_times.push_back(free_time);
+    context->schedule_event(free_time, unmaterialized_links_become_free, new LinkFreeCallbackArg{shared_from_this(), device_id});
+}
 
-    //     // re-assign the route
-    //     chunk->update_route(routes[chunk->next_device()->get_id()], 0);
+bool Device::connected(const DeviceId dest) const noexcept {
+    assert(dest >= 0);
 
-    //     // re-send the chunk
-    //     send(std::move(chunk));
-    // }
+    // connected to every device by connect_all
+    return dest < devices_count;
 }
 
-void Device::disconnect(const DeviceId id) noexcept {
-    assert(id >= 0);
+Device::Port& Device::port(const DeviceId dest) noexcept {
+    assert(connected(dest));
 
-    // assert there's an existing connection
-    assert(connected(id));
+    const auto it = ports.find(dest);
+    if (it != ports.end()) {
+        return it->second;
+    }
 
-    // remove the link
-    links.erase(id);
-}
+    // materialize the link with the zero bandwidth and latency it was connected with
+    auto& new_port = ports.try_emplace(dest, Bandwidth(0), Latency(0), context).first->second;
+    if (dest != device_id) {
+        materialized_peers_count++;
+    }
 
-bool Device::connected(const DeviceId dest) const noexcept {
-    assert(dest >= 0);
+    // the link takes over the free events pending for unmaterialized links
+    for (const auto free_time : unmaterialized_free_times) {
+        context->schedule_event(free_time, link_become_free, new LinkFreeCallbackArg{shared_from_this(), dest});
+    }
 
-    // check whether the connection exists
-    return links.find(dest) != links.end();
+    return new_port;
 }
@@ -5,6 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "reconfigurable/Link.h"
 #include "common/NetworkFunction.h"
+#include "common/Trace.h"
 #include "reconfigurable/Chunk.h"
 #include "reconfigurable/Device.h"
 #include <cassert>
@@ -14,41 +15,15 @@ LICENSE file in the root directory of this source tree.
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalReconfigurable;
 
-// declaring static event_queue
-std::shared_ptr<EventQueue> Link::event_queue;
-
-
-int NetworkAnalyticalReconfigurable::Link::num_drained_links = 0;
-std::function<void()> Link::increment_callback = []() { };
-
-void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
-    assert(event_queue_ptr != nullptr);
-
-    // set the event queue
-    Link::event_queue = std::move(event_queue_ptr);
-}
-
-int Link::get_current_time() noexcept {
-    assert(event_queue != nullptr);
-
-    // return current time of the event queue
-    return Link::event_queue->get_current_time();
-}
-
-void Link::schedule_event(EventTime event_time, Callback callback, void* const arg) noexcept {
-    assert(event_queue != nullptr);
-    assert(callback != nullptr);
-
-    // schedule the event in the event queue
-    Link::event_queue->schedule_event(event_time, callback, arg);
-}
-
-Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
-    : bandwidth(bandwidth),
+Link::Link(const Bandwidth bandwidth, const Latency latency, SimulationContext* const context) noexcept
+    : context(context),
+      bandwidth(bandwidth),
       latency(latency),
-      busy(false) {
+      busy(false),
+      telemetry(nullptr) {
     assert(bandwidth >= 0);
     assert(latency >= 0);
+    assert(context != nullptr);
 
     // convert bandwidth from GB/s to B/ns
     bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
@@ -66,6 +41,28 @@ unsigned long Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     return schedule_chunk_transmission(std::move(chunk));
 }
 
+void Link::record_queue_depth(const size_t queue_depth) noexcept {
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        link_telemetry->record_queue_depth(context->get_current_time(), queue_depth);
+    }
+}
+
+const LinkTelemetry* Link::get_telemetry() const noexcept {
+    return telemetry.get();
+}
+
+LinkTelemetry* Link::telemetry_to_record() noexcept {
+    if (!context->is_link_telemetry_enabled()) {
+        return nullptr;
+    }
+
+    // created lazily, so idle links cost nothing
+    if (telemetry == nullptr) {
+        telemetry = std::make_unique<LinkTelemetry>();
+    }
+    return telemetry.get();
+}
+
 void Link::set_busy() noexcept {
     // set busy to true
     busy = true;
@@ -107,13 +104,17 @@ unsigned long Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) no
 
     // get metadata
     const auto chunk_size = chunk->get_size();
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto current_time = context->get_current_time();
 
     // schedule chunk arrival event
     const auto communication_time = communication_delay(chunk_size);
     const auto chunk_arrival_time = current_time + communication_time;
+    if (auto* const link_telemetry = telemetry_to_record(); link_telemetry != nullptr) {
+        link_telemetry->record_transmission(chunk->get_ready_time(), current_time,
+                                            current_time + serialization_delay(chunk_size), chunk_size);
+    }
     auto* const chunk_ptr = static_cast<void*>(chunk.release());
-    Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    context->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
     
     // schedule link free time
     const auto serialization_time = serialization_delay(chunk_size);
@@ -123,17 +124,14 @@ unsigned long Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) no
 
 unsigned long Link::reconfigure(Bandwidth bandwidth, Latency latency, Latency reconfig_time) noexcept{
     if (bandwidth == this->bandwidth && latency == this->latency) {
-        std::cout << "No reconfiguration needed" << std::endl;
-        return Link::event_queue->get_current_time() + 1;
+        ANALYTICAL_TRACE(Debug, LinkReconfigurationSkipped, context->get_current_time(), bandwidth, latency);
+        return context->get_current_time() + 1;
     }
 
     assert(!busy);
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto current_time = context->get_current_time();
     set_busy();
 
-    printf("Reconfiguring link from bandwidth %.2f GB/s to %.2f GB/s and latency %.2f ns to %.2f ns at time %lu ns\n",
-           this->bandwidth, bandwidth, this->latency, latency, current_time);
-
     this->bandwidth = bandwidth;
     this->latency = latency;
     this->bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
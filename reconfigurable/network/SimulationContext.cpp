@@ -0,0 +1,84 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "reconfigurable/SimulationContext.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalReconfigurable;
+
+std::shared_ptr<SimulationContext> SimulationContext::default_context() noexcept {
+    static const auto context = std::make_shared<SimulationContext>();
+
+    return context;
+}
+
+SimulationContext::SimulationContext(std::shared_ptr<EventQueue> event_queue) noexcept
+    : event_queue(std::move(event_queue)),
+      on_link_drained([]() {}),
+      num_drained_links(0),
+      drain_all_flow(true),
+      link_telemetry_enabled(false) {}
+
+void SimulationContext::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
+    assert(event_queue != nullptr);
+
+    this->event_queue = std::move(event_queue);
+}
+
+std::shared_ptr<EventQueue> SimulationContext::get_event_queue() const noexcept {
+    return event_queue;
+}
+
+EventTime SimulationContext::get_current_time() const noexcept {
+    assert(event_queue != nullptr);
+
+    return event_queue->get_current_time();
+}
+
+void SimulationContext::schedule_event(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg arg) noexcept {
+    assert(event_queue != nullptr);
+    assert(callback != nullptr);
+
+    event_queue->schedule_event(event_time, callback, arg);
+}
+
+void SimulationContext::set_increment_callback(std::function<void()> callback) noexcept {
+    assert(callback != nullptr);
+
+    on_link_drained = std::move(callback);
+}
+
+void SimulationContext::increment_callback() const noexcept {
+    on_link_drained();
+}
+
+int SimulationContext::get_num_drained_links() const noexcept {
+    return num_drained_links;
+}
+
+void SimulationContext::set_num_drained_links(const int num_drained_links) noexcept {
+    assert(num_drained_links >= 0);
+
+    this->num_drained_links = num_drained_links;
+}
+
+bool SimulationContext::is_drain_all_flow() const noexcept {
+    return drain_all_flow;
+}
+
+void SimulationContext::set_drain_all_flow(const bool drain_all_flow) noexcept {
+    this->drain_all_flow = drain_all_flow;
+}
+
+void SimulationContext::set_link_telemetry_enabled(const bool enabled) noexcept {
+    link_telemetry_enabled = enabled;
+}
+
+bool SimulationContext::is_link_telemetry_enabled() const noexcept {
+    return link_telemetry_enabled;
+}
@@ -1,5 +1,6 @@
 
 #include "reconfigurable/TopologyManager.h"
+#include "common/Trace.h"
 #include <cassert>
 #include <algorithm>
 #include <iostream>
@@ -7,13 +8,22 @@
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalReconfigurable;
 
-TopologyManager::TopologyManager(int npus_count, int devices_count, EventQueue* event_queue, std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules) noexcept {
+TopologyManager::TopologyManager(int npus_count, int devices_count, EventQueue* event_queue, std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules) noexcept
+    : TopologyManager(npus_count, devices_count, SimulationContext::default_context(), std::move(circuit_schedules)) {
+    // the default context must be driven by the given event queue
+    assert(context->get_event_queue().get() == event_queue);
+}
+
+TopologyManager::TopologyManager(int npus_count, int devices_count, std::shared_ptr<SimulationContext> context, std::map<int, std::vector<std::vector<Bandwidth>>> circuit_schedules) noexcept {
+    assert(context != nullptr);
+
     // Initialize the number of NPUs
     this->npus_count = npus_count;
     this->devices_count = devices_count;
-    this->event_queue = event_queue;
+    this->context = std::move(context);
     this->circuit_schedules = std::move(circuit_schedules);
-    printf("Circuit schedules size: %zu\n", this->circuit_schedules.size());
+    ANALYTICAL_TRACE(Info, CircuitSchedulesLoaded, this->context->get_current_time(),
+                     this->circuit_schedules.size());
 
     // Validate the counts
     assert(npus_count > 0);
@@ -23,17 +33,12 @@ TopologyManager::TopologyManager(int npus_count, int devices_count, EventQueue*
     reconfiguring = false;
 
     // Initialize the topology
-    topology = std::make_shared<Topology>(npus_count, devices_count);
-
-    Link::increment_callback = [this]() noexcept {
-        // Increment the topology iteration
-        this->increment_callback();
-    };
+    topology = std::make_shared<Topology>(npus_count, devices_count, this->context);
 
-    Device::increment_callback = [this]() noexcept {
+    this->context->set_increment_callback([this]() noexcept {
         // Increment the topology iteration
         this->increment_callback();
-    };
+    });
 
     // Initialize bandwidth and latency matrices
     bandwidths.resize(devices_count, std::vector<Bandwidth>(devices_count, Bandwidth(0)));
@@ -52,16 +57,15 @@ std::shared_ptr<Device> TopologyManager::get_device(const DeviceId deviceId) noe
 
 void TopologyManager::drain_network() noexcept {
     // Drain the network by iterating through all devices and their links
-    Link::num_drained_links = 0;
+    context->set_num_drained_links(0);
     for (int i = 0; i < devices_count; ++i) {
         auto device = topology->get_device(i);
         device->draining = true;
-        for(int j = 0; j < devices_count; ++j) {
-            if (i != j) {
-                auto link = device->get_link(j);
-                if(!link->is_busy()) increment_callback();
-                // TODO what if the link is busy, or the link does not exist
-            }
+        // count idle links without materializing the ones never used
+        const auto idle_links_count = device->idle_links_count();
+        for (int j = 0; j < idle_links_count; ++j) {
+            increment_callback();
+            // TODO what if the link is busy, or the link does not exist
         }
     }
 }
@@ -72,43 +76,30 @@ bool TopologyManager::is_reconfiguring() const noexcept {
 
 void TopologyManager::increment_callback() noexcept {
     if(!reconfiguring){
-        Link::num_drained_links = 0;
+        context->set_num_drained_links(0);
         return;
     }
 
     // Increment the topology iteration
-    Link::num_drained_links++;
-    // printf("Link drained: %d/%d at %d\n", Link::num_drained_links, devices_count * (devices_count - 1), Link::get_current_time());
+    const auto num_drained_links = context->get_num_drained_links() + 1;
+    context->set_num_drained_links(num_drained_links);
 
-    if(Link::num_drained_links < devices_count * (devices_count - 1)) {
+    if(num_drained_links < devices_count * (devices_count - 1)) {
         // TODO: what if not all devices are connected to each other?
         return;
     }
 
-    Link::num_drained_links = 0;
+    context->set_num_drained_links(0);
     reconfiguring = false;
 
     // All links have been drained, increment the topology iteration
-    std::cout << "Drained Network, reconfiguring to TOPO ITERATION #" << topology_iteration << std::endl;
-    for(auto row:bandwidths){
-        for(auto bw: row){
-            std::cout << bw << " ";
-        }
-        std::cout << std::endl;
-    }
+    ANALYTICAL_TRACE(Info, NetworkDrained, context->get_current_time(), topology_iteration);
 
 
     for (int i = 0; i < devices_count; ++i) {
         auto device = topology->get_device(i);
         // std::vector<Route> routes;
         // Create a route for each device
-        std::vector<Bandwidth> bw_device = bandwidths[i];
-        std::cout << "BW Vector for device " << i << std::endl;
-        for (auto bw: bw_device){
-            std::cout << bw << " ";
-        }
-        std::cout << std::endl;
-
         device->reconfigure(bandwidths[i], precomputed_routes[i], latencies[i], reconfig_time);
     }
 }
@@ -117,25 +108,20 @@ bool TopologyManager::reconfigure(std::vector<std::vector<Bandwidth>> bandwidths
                                std::vector<std::vector<Latency>> latencies, Latency reconfig_time, int topo_id) noexcept {
     
     if (topo_id == cur_topo_id) {
-        std::cout << "TM: Already in the requested topology and reconfiguring, ignoring reconfiguration request to topo_id " << topo_id << std::endl;
+        ANALYTICAL_TRACE(Info, ReconfigurationIgnored, context->get_current_time(), topo_id);
         return true;
     }
 
     if ((is_reconfiguring() || inflight_coll > 0)) {
         // TODO check condition
-        std::cout << "\nTM: trying to reconfig, inflight coll: " << inflight_coll << ", is reconfiguring? " << is_reconfiguring() << ", is event queue finished? " << event_queue->finished() << std::endl;
-        // event_queue->proceed();
+        ANALYTICAL_TRACE(Info, ReconfigurationDeferred, context->get_current_time(), topo_id, inflight_coll,
+                         is_reconfiguring());
+        // context->get_event_queue()->proceed();
         return false;
     }
 
-    printf("\nTM: !!! Reconfig to topo_id: %d, Devices count: %d, NPUs count: %d, inflight_coll %d\n", topo_id, devices_count, npus_count, inflight_coll);
-    printf("bandwidths size: %zu, latencies size: %zu\n\n", bandwidths.size(), latencies.size());
-    for(auto row:bandwidths){
-        for(auto bw: row){
-            std::cout << bw << " ";
-        }
-        std::cout << std::endl;
-    }
+    ANALYTICAL_TRACE(Info, ReconfigurationRequested, context->get_current_time(), topo_id, devices_count, npus_count,
+                     inflight_coll);
 
     assert(bandwidths.size() == devices_count);
     assert(latencies.size() == devices_count);
@@ -169,8 +155,9 @@ bool TopologyManager::reconfigure(int topo_id) noexcept{
     if (it != circuit_schedules.end()) {
         return reconfigure(it->second, latencies, reconfig_time, topo_id);
     } else {
-        printf("Topology ID %d not found in circuit schedules.\n", topo_id);
-        exit(1);
+        std::cerr << "[Error] (network/analytical/reconfigurable) " << "topology id " << topo_id
+                  << " not found in circuit schedules" << std::endl;
+        std::exit(-1);
     }
 }
 
@@ -224,12 +211,12 @@ void TopologyManager::precomputeRoutes() noexcept {
         // Reconstruct a path s -> t for all t
         for (int t = 0; t < devices_count; ++t) {
             if (s == t) {
-                precomputed_routes[s][t] = {topology->get_device(s)};
+                precomputed_routes[s][t] = {s};
             } else if (parent[t] == -1) {
-                precomputed_routes[s][t] = {topology->get_device(s), topology->get_device(t)}; // Unreachable, stub route
+                precomputed_routes[s][t] = {s, t}; // Unreachable, stub route
             } else {
                 Route path;
-                for (int cur = t; cur != -1; cur = parent[cur]) path.push_back(topology->get_device(cur));
+                for (int cur = t; cur != -1; cur = parent[cur]) path.push_back(cur);
                 reverse(path.begin(), path.end());
                 precomputed_routes[s][t] = move(path);
             }
@@ -239,22 +226,18 @@ void TopologyManager::precomputeRoutes() noexcept {
 
 void TopologyManager::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
-    assert(chunk->current_device() != nullptr);
-    // chunk->update_route(route(chunk->current_device()->get_id(), chunk->next_device()->get_id()), topology_iteration);
+    // chunk->update_route(route(chunk->current_device_id(), chunk->next_device_id()), topology_iteration);
 
     // Get the source device ID
-    DeviceId src = chunk->current_device()->get_id();
+    DeviceId src = chunk->current_device_id();
     assert(src >= 0 && src < devices_count);
 
     if(chunk->get_topology_iteration() == -1){
-        chunk->update_route(route(src, chunk->next_device()->get_id()), topology_iteration);
+        chunk->update_route(route(src, chunk->next_device_id()), topology_iteration);
     }
 
-    printf("TM: Sending chunk from %d to %d, in topo iter %d, route: ", chunk->current_device()->get_id(), chunk->next_device()->get_id(), chunk->get_topology_iteration());
-    for(auto device : chunk->route){
-        printf("%d ", device->get_id());
-    }
-    printf("\n");
+    ANALYTICAL_TRACE(Debug, ChunkRouted, context->get_current_time(), chunk->current_device_id(),
+                     chunk->next_device_id(), chunk->get_topology_iteration(), chunk->get_route().size());
 
     // Send the chunk through the topology
     topology->send(std::move(chunk));
@@ -266,10 +249,6 @@ Route TopologyManager::route(DeviceId src, DeviceId dest) const noexcept {
     assert(dest >= 0 && dest < npus_count);
 
     // Without any host forwarding.
-    Route route;
-    route.push_back(topology->get_device(src));
-
     // Create a route that includes the src and dest devices
-    route.push_back(topology->get_device(dest));
-    return route;
+    return Route{src, dest};
 }
\ No newline at end of file
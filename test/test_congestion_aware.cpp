@@ -3,12 +3,25 @@ This source code is licensed under the MIT license found in the
 LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
+#include "common/ChromeTraceWriter.h"
 #include "common/EventQueue.h"
+#include "common/LinkTelemetry.h"
+#include "common/NetworkFunction.h"
 #include "common/NetworkParser.h"
 #include "common/Type.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/CollectiveEngine.h"
+#include "congestion_aware/FlowSimulator.h"
+#include "congestion_aware/FullyConnected.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/ParallelSimulator.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/SimulationContext.h"
 #include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -132,3 +145,468 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     const auto simulation_time = event_queue->get_current_time();
     EXPECT_EQ(simulation_time, 704'116);
 }
+
+/// arrival time slot of a chunk
+struct ArrivalSlot {
+    /// event queue of a sequential run, nullptr when run by a ParallelSimulator
+    EventQueue* event_queue;
+
+    /// where to record the arrival time
+    EventTime* arrival_time;
+};
+
+/// records the arrival time of a chunk into its slot
+static void record_arrival(void* const arg) {
+    auto* const slot = static_cast<ArrivalSlot*>(arg);
+    *slot->arrival_time =
+        (slot->event_queue != nullptr) ? slot->event_queue->get_current_time() : ParallelSimulator::current_time();
+}
+
+/// outcome of an All-to-All run
+struct AllToAllResult {
+    /// arrival time of each chunk
+    std::vector<EventTime> arrival_times;
+
+    /// time the last chunk arrived
+    EventTime finish_time;
+
+    /// number of event queue proceeds, counted by sequential runs only
+    int proceeds_count;
+};
+
+/**
+ * Run All-to-All of 1 MB messages on the given topology.
+ *
+ * @param path network configuration file
+ * @param threads_count number of threads of a ParallelSimulator, or 0 to drive the event queue sequentially
+ * @param link_model link model of the simulation
+ * @param max_train_length maximum number of chunks in a train
+ * @param chunks_per_message number of chunks each message is split into
+ * @return arrival time of each chunk, finish time and number of proceeds
+ */
+static AllToAllResult run_all_to_all(const std::string& path,
+                                     const int threads_count,
+                                     const LinkModel link_model = LinkModel::EventDriven,
+                                     const size_t max_train_length = 1,
+                                     const int chunks_per_message = 1) {
+    const auto network_parser = NetworkParser(path);
+    const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+    context->set_link_model(link_model);
+    context->set_max_train_length(max_train_length);
+    const auto topology = construct_topology(network_parser, context);
+    const auto npus_count = topology->get_npus_count();
+    const auto event_queue = context->get_event_queue();
+
+    auto simulator = std::unique_ptr<ParallelSimulator>();
+    if (threads_count > 0) {
+        simulator = std::make_unique<ParallelSimulator>(topology, threads_count);
+    }
+
+    const auto chunks_count = npus_count * npus_count * chunks_per_message;
+    auto result = AllToAllResult{std::vector<EventTime>(chunks_count, 0), 0, 0};
+    auto slots = std::vector<ArrivalSlot>(chunks_count);
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+            const auto route = topology->cached_route(i, j);
+            for (int k = 0; k < chunks_per_message; k++) {
+                const auto index = (i * npus_count + j) * chunks_per_message + k;
+                slots[index] = {simulator ? nullptr : event_queue.get(), &result.arrival_times[index]};
+                auto chunk = std::make_unique<Chunk>(1'048'576 / chunks_per_message, route, record_arrival,
+                                                     &slots[index]);
+                if (simulator) {
+                    simulator->send(std::move(chunk));
+                } else {
+                    topology->send(std::move(chunk));
+                }
+            }
+        }
+    }
+
+    if (simulator) {
+        simulator->run();
+        result.finish_time = simulator->get_current_time();
+    } else {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+            result.proceeds_count++;
+        }
+        result.finish_time = event_queue->get_current_time();
+    }
+    return result;
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ParallelMatchesSequential) {
+    /// test: every chunk arrives at the same time regardless of the number of threads
+    for (const auto* const input : {"Ring", "FullyConnected", "Switch"}) {
+        const auto path = std::string("../../input/") + input + ".yml";
+        const auto sequential = run_all_to_all(path, 0);
+        for (const auto threads_count : {1, 2, 3, 8}) {
+            const auto parallel = run_all_to_all(path, threads_count);
+            EXPECT_EQ(parallel.arrival_times, sequential.arrival_times)
+                << input << " with " << threads_count << " threads";
+            EXPECT_EQ(parallel.finish_time, sequential.finish_time)
+                << input << " with " << threads_count << " threads";
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ReservationMatchesEventDriven) {
+    /// test: reserving links yields the same transmission times as link free events
+    for (const auto* const input : {"Ring", "FullyConnected", "Switch"}) {
+        const auto path = std::string("../../input/") + input + ".yml";
+        for (const auto threads_count : {1, 4}) {
+            const auto reservation = run_all_to_all(path, threads_count, LinkModel::Reservation);
+            const auto event_driven = run_all_to_all(path, threads_count, LinkModel::EventDriven);
+            EXPECT_EQ(reservation.arrival_times, event_driven.arrival_times)
+                << input << " with " << threads_count << " threads";
+            EXPECT_EQ(reservation.finish_time, event_driven.finish_time)
+                << input << " with " << threads_count << " threads";
+        }
+    }
+
+    /// test: chunks queued behind each other in a sequential simulation
+    const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+    context->set_link_model(LinkModel::Reservation);
+    const auto topology = std::make_shared<Ring>(8, 50, 500);
+    topology->set_context(context);
+    for (auto i = 0; i < 3; i++) {
+        topology->send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), callback, nullptr));
+    }
+    const auto event_queue = context->get_event_queue();
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(event_queue->get_current_time(), 60'093 + 2 * 19'531);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, FastPath) {
+    /// test: contended transfers fall back to per-hop simulation
+    for (const auto* const input : {"Ring", "FullyConnected", "Switch"}) {
+        const auto path = std::string("../../input/") + input + ".yml";
+        EXPECT_EQ(run_all_to_all(path, 0, LinkModel::FastPath).arrival_times,
+                  run_all_to_all(path, 0, LinkModel::EventDriven).arrival_times)
+            << input;
+    }
+
+    /// test: an uncongested multi-hop chunk takes a single event
+    const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+    context->set_link_model(LinkModel::FastPath);
+    const auto topology = std::make_shared<Ring>(8, 50, 500);
+    topology->set_context(context);
+    topology->send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), callback, nullptr));
+    const auto event_queue = context->get_event_queue();
+    auto proceeds_count = 0;
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+        proceeds_count++;
+    }
+    EXPECT_EQ(event_queue->get_current_time(), 60'093);
+    EXPECT_EQ(proceeds_count, 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChunkTrains) {
+    /// test: back-to-back chunks travel as trains, each chunk arriving as it would on its own
+    const auto chunks_per_message = 16;
+    const auto path = std::string("../../input/Ring.yml");
+    const auto chunks = run_all_to_all(path, 0, LinkModel::EventDriven, 1, chunks_per_message);
+    const auto trains = run_all_to_all(path, 0, LinkModel::EventDriven, chunks_per_message, chunks_per_message);
+    EXPECT_EQ(trains.arrival_times, chunks.arrival_times);
+    EXPECT_LT(trains.proceeds_count, chunks.proceeds_count);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, IndependentContexts) {
+    /// run the Ring test in several simulations at once, each in its own context
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    auto simulation_times = std::vector<EventTime>(4, 0);
+    auto threads = std::vector<std::thread>();
+    for (auto& simulation_time : simulation_times) {
+        threads.emplace_back([&network_parser, &simulation_time, this]() {
+            const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+            const auto topology = construct_topology(network_parser, context);
+            topology->send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), callback, nullptr));
+
+            const auto event_queue = context->get_event_queue();
+            while (!event_queue->finished()) {
+                event_queue->proceed();
+            }
+            simulation_time = event_queue->get_current_time();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// test
+    for (const auto simulation_time : simulation_times) {
+        EXPECT_EQ(simulation_time, 60'093);
+    }
+
+    // the default context is left untouched
+    EXPECT_TRUE(event_queue->finished());
+    EXPECT_EQ(event_queue->get_current_time(), 0);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CachedRoute) {
+    /// routes of small topologies are built for all pairs, large ones are memoized
+    for (const auto npus_count : {8, 200}) {
+        const auto topology = std::make_shared<Ring>(npus_count, 50, 500);
+
+        /// test: every chunk between the same pair shares one route, identical to route()
+        for (const auto& [src, dest] : {std::pair{1, 4}, std::pair{4, 1}, std::pair{0, npus_count - 1}}) {
+            const auto route = topology->cached_route(src, dest);
+            EXPECT_EQ(*route, topology->route(src, dest));
+            EXPECT_EQ(route.get(), topology->cached_route(src, dest).get());
+        }
+
+        /// test: a chunk on a shared route travels as one on its own route
+        const auto start_time = event_queue->get_current_time();
+        topology->send(std::make_unique<Chunk>(chunk_size, topology->cached_route(1, 4), callback, nullptr));
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        const auto shared_route_time = event_queue->get_current_time() - start_time;
+        EXPECT_EQ(shared_route_time, 60'093);
+
+        topology->send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), callback, nullptr));
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_EQ(event_queue->get_current_time() - start_time, 2 * shared_route_time);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LazyLinks) {
+    /// links of a large fully-connected topology are only materialized on use
+    const auto topology = std::make_shared<FullyConnected>(4'096, 50, 500);
+    for (auto i = 0; i < topology->get_devices_count(); i++) {
+        EXPECT_EQ(topology->get_device(i)->get_materialized_links_count(), 0);
+    }
+
+    /// test: a chunk materializes the single link it crosses
+    const auto start_time = event_queue->get_current_time();
+    topology->send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), callback, nullptr));
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(topology->get_device(1)->get_materialized_links_count(), 1);
+    EXPECT_EQ(topology->get_device(4)->get_materialized_links_count(), 0);
+
+    /// test: a materialized link behaves as a small topology's one
+    const auto small_topology = std::make_shared<FullyConnected>(8, 50, 500);
+    const auto lazy_time = event_queue->get_current_time() - start_time;
+    small_topology->send(std::make_unique<Chunk>(chunk_size, small_topology->route(1, 4), callback, nullptr));
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(event_queue->get_current_time() - start_time, 2 * lazy_time);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, FlowSimulator) {
+    /// setup: flows recording their arrival time
+    const auto topology = std::make_shared<Ring>(8, 50, 500);
+    auto flow_simulator = FlowSimulator(topology);
+    struct Arrival {
+        const EventQueue* event_queue;
+        EventTime time;
+    };
+    const auto record_arrival = [](void* const arg) {
+        auto* const arrival = static_cast<Arrival*>(arg);
+        arrival->time = arrival->event_queue->get_current_time();
+    };
+    const auto run = [&]() {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    };
+
+    /// test: an uncongested flow serializes once, then adds the latency of every hop
+    const auto start_time = event_queue->get_current_time();
+    auto single = Arrival{event_queue.get(), 0};
+    flow_simulator.send(std::make_unique<Chunk>(chunk_size, topology->route(1, 4), record_arrival, &single));
+    run();
+    const auto transmission_time = single.time - start_time - 3 * 500;
+    EXPECT_NEAR(transmission_time, 19'531, 1);
+
+    /// test: max-min fairness, flows share link 2->3 equally, and flow 1->2 takes what's left of link 1->2
+    const auto shared_start_time = event_queue->get_current_time();
+    auto arrivals = std::vector<Arrival>(4, Arrival{event_queue.get(), 0});
+    const auto routes = std::vector<Route>{topology->route(1, 3), topology->route(1, 2), topology->route(2, 3),
+                                           topology->route(2, 3)};
+    for (auto i = 0; i < 4; i++) {
+        flow_simulator.send(std::make_unique<Chunk>(chunk_size, routes[i], record_arrival, &arrivals[i]));
+    }
+    run();
+    EXPECT_NEAR(arrivals[0].time - shared_start_time, 3 * transmission_time + 2 * 500, 2);
+    EXPECT_NEAR(arrivals[1].time - shared_start_time, 3 * transmission_time / 2 + 500, 2);
+    EXPECT_NEAR(arrivals[2].time - shared_start_time, 3 * transmission_time + 500, 2);
+    EXPECT_EQ(flow_simulator.get_active_flows_count(), 0);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, CollectiveEngine) {
+    /// setup: delay of a chunk over a single uncongested link
+    const auto hop_delay = [](const ChunkSize size) {
+        return static_cast<EventTime>(500 + static_cast<Bandwidth>(size) / bw_GBps_to_Bpns(50));
+    };
+    const auto run = [&](const std::shared_ptr<Topology>& topology, const CollectiveType type,
+                         const CollectiveAlgorithm algorithm, const ChunkSize size) {
+        auto engine = CollectiveEngine(topology);
+        const auto collective_id = engine.run(type, algorithm, size);
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_TRUE(engine.is_finished(collective_id));
+        return engine.get_finish_time(collective_id) - engine.get_start_time(collective_id);
+    };
+    const auto ring = std::make_shared<Ring>(8, 50, 500);
+    const auto fully_connected = std::make_shared<FullyConnected>(8, 50, 500);
+    const auto size = 8 * chunk_size;
+
+    /// test: ring steps between neighbors never contend for a link
+    EXPECT_EQ(run(ring, CollectiveType::AllGather, CollectiveAlgorithm::Ring, size), 7 * hop_delay(chunk_size));
+    EXPECT_EQ(run(ring, CollectiveType::AllReduce, CollectiveAlgorithm::Ring, size), 14 * hop_delay(chunk_size));
+    EXPECT_EQ(run(ring, CollectiveType::AllReduce, CollectiveAlgorithm::Hierarchical, size),
+              14 * hop_delay(chunk_size));
+
+    /// test: direct and halving-doubling steps take a single link each on a fully-connected topology
+    EXPECT_EQ(run(fully_connected, CollectiveType::AllToAll, CollectiveAlgorithm::Direct, size),
+              hop_delay(chunk_size));
+    EXPECT_EQ(run(fully_connected, CollectiveType::AllReduce, CollectiveAlgorithm::HalvingDoubling, size),
+              2 * (hop_delay(size / 2) + hop_delay(size / 4) + hop_delay(size / 8)));
+
+    /// test: concurrent collectives share links, and report their own completion
+    auto engine = CollectiveEngine(ring);
+    const auto first = engine.run(CollectiveType::AllGather, CollectiveAlgorithm::Ring, size);
+    const auto second = engine.run(CollectiveType::ReduceScatter, CollectiveAlgorithm::Direct, size);
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(engine.get_chunks_count(first), 8 * 7);
+    EXPECT_EQ(engine.get_chunks_count(second), 8 * 7);
+    EXPECT_GT(engine.get_finish_time(first) - engine.get_start_time(first), 7 * hop_delay(chunk_size));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkTelemetry) {
+    /// run three chunks queued on link 0 -> 1, returning the telemetry of every link and the end time
+    const auto run = [&](const LinkModel link_model) {
+        const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+        context->set_link_model(link_model);
+        context->set_link_telemetry_enabled(true);
+        const auto topology = std::make_shared<Ring>(4, 50, 500);
+        topology->set_context(context);
+        for (auto i = 0; i < 3; i++) {
+            topology->send(std::make_unique<Chunk>(chunk_size, topology->route(0, 1), callback, nullptr));
+        }
+        const auto event_queue = context->get_event_queue();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        return std::make_pair(topology->get_link_telemetry(), event_queue->get_current_time());
+    };
+    const auto serialization_time = EventTime{19'531};
+
+    /// test: only the used link reports, with the time each chunk waited for it
+    const auto [entries, end_time] = run(LinkModel::EventDriven);
+    ASSERT_EQ(entries.size(), 1);
+    const auto& [src, dest, telemetry] = entries[0];
+    EXPECT_EQ(src, 0);
+    EXPECT_EQ(dest, 1);
+    EXPECT_EQ(telemetry.get_bytes(), 3 * chunk_size);
+    EXPECT_EQ(telemetry.get_chunks_count(), 3);
+    EXPECT_EQ(telemetry.get_busy_time(), 3 * serialization_time);
+    EXPECT_EQ(telemetry.get_max_queue_depth(), 2);
+    EXPECT_DOUBLE_EQ(telemetry.get_mean_queue_depth(end_time), 3.0 * serialization_time / end_time);
+    EXPECT_DOUBLE_EQ(telemetry.get_mean_queueing_delay(), serialization_time);
+    const auto& histogram = telemetry.get_queueing_delay_histogram();
+    EXPECT_EQ(histogram[0], 1);
+    EXPECT_EQ(histogram[LinkTelemetry::histogram_bucket(serialization_time)], 1);
+    EXPECT_EQ(histogram[LinkTelemetry::histogram_bucket(2 * serialization_time)], 1);
+
+    /// test: the reservation model counts the same transmissions
+    const auto [reserved_entries, reserved_end_time] = run(LinkModel::Reservation);
+    ASSERT_EQ(reserved_entries.size(), 1);
+    EXPECT_EQ(reserved_end_time, end_time);
+    EXPECT_EQ(reserved_entries[0].telemetry.get_busy_time(), telemetry.get_busy_time());
+    EXPECT_EQ(reserved_entries[0].telemetry.get_queueing_delay_histogram(), histogram);
+
+    /// test: telemetry is written keyed by (src, dest)
+    auto csv = std::ostringstream();
+    write_link_telemetry_csv(entries, end_time, csv);
+    EXPECT_EQ(csv.str().rfind("src,dest,bytes,", 0), 0);
+    EXPECT_NE(csv.str().find("\n0,1,3145728,3,58593,"), std::string::npos);
+    auto json = std::ostringstream();
+    write_link_telemetry_json(entries, end_time, json);
+    EXPECT_NE(json.str().find("{\"src\": 0, \"dest\": 1, \"bytes\": 3145728,"), std::string::npos);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChromeTrace) {
+    /// run two chunks over two hops each, returning the trace written
+    const auto run = [&](const LinkModel link_model) {
+        auto trace = std::ostringstream();
+        const auto writer = std::make_shared<ChromeTraceWriter>(trace);
+        const auto context = std::make_shared<SimulationContext>(std::make_shared<EventQueue>());
+        context->set_link_model(link_model);
+        context->set_chrome_trace_writer(writer);
+        const auto topology = std::make_shared<Ring>(4, 50, 500);
+        topology->set_context(context);
+        topology->send(std::make_unique<Chunk>(chunk_size, topology->route(0, 2), callback, nullptr));
+        topology->send(std::make_unique<Chunk>(chunk_size, topology->route(3, 1), callback, nullptr));
+        const auto event_queue = context->get_event_queue();
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        EXPECT_EQ(writer->get_hops_count(), 4);
+        writer->close();
+        return trace.str();
+    };
+
+    /// test: each hop is a busy interval on the track of its link, with times in us
+    const auto trace = run(LinkModel::EventDriven);
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n", 0), 0);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+    EXPECT_NE(trace.find("\"args\": {\"name\": \"link 0 -> 1\"}"), std::string::npos);
+    EXPECT_NE(trace.find("{\"name\": \"transmission\", \"ph\": \"X\", \"ts\": 20.031, \"pid\": 1, \"tid\": 2, "
+                         "\"dur\": 19.531, \"args\": {\"chunk_src\": 0, \"chunk_dest\": 2, \"size\": 1048576"),
+              std::string::npos);
+
+    /// test: hops collapsed by the fast path are traced as they took place
+    EXPECT_NE(run(LinkModel::FastPath).find("\"ts\": 20.031, \"pid\": 1, \"tid\": 2,"), std::string::npos);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ChunkPoolRecycles) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    const auto chunks_count = static_cast<uint64_t>(npus_count * (npus_count - 1));
+
+    /// run All-to-All, returning the pool statistics before and after
+    const auto send_all_to_all_and_snapshot = [&]() {
+        const auto stats = ChunkPool::get_stats();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    topology->send(std::make_unique<Chunk>(chunk_size, topology->cached_route(i, j), callback, nullptr));
+                }
+            }
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        return std::pair{stats, ChunkPool::get_stats()};
+    };
+
+    /// test: the pool warms up in the first run, and recycles every chunk in the next one
+    const auto [warmup_before, warmup_after] = send_all_to_all_and_snapshot();
+    EXPECT_EQ(warmup_after.allocations_count - warmup_before.allocations_count, chunks_count);
+    EXPECT_EQ(warmup_after.live_count, warmup_before.live_count);
+
+    const auto [before, after] = send_all_to_all_and_snapshot();
+    EXPECT_EQ(after.allocations_count - before.allocations_count, chunks_count);
+    EXPECT_EQ(after.recycled_count - before.recycled_count, chunks_count);
+    EXPECT_EQ(after.peak_live_count, before.peak_live_count);
+    EXPECT_EQ(after.reserved_bytes, before.reserved_bytes);
+    EXPECT_EQ(after.live_count, before.live_count);
+}
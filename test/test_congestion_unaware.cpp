@@ -6,7 +6,14 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkParser.h"
 #include "common/Type.h"
 #include "congestion_unaware/Helper.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
@@ -68,3 +75,111 @@ TEST_F(TestNetworkAnalyticalCongestionUnaware, Ring_FullyConnected_Switch) {
     const auto comm_delay_dim3 = topology->send(26, 42, chunk_size);
     EXPECT_EQ(comm_delay_dim3, 23'531);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, EstimateCollective) {
+    /// test: ring steps on a single dimension send to the neighbor
+    const auto ring = construct_topology(NetworkParser("../../input/Ring.yml"));
+    const auto ring_size = 16 * chunk_size;
+    EXPECT_EQ(ring->estimate_collective(CollectiveType::AllGather, CollectiveAlgorithm::Ring, ring_size),
+              15 * 20'031);
+    EXPECT_EQ(ring->estimate_collective(CollectiveType::AllReduce, CollectiveAlgorithm::Ring, ring_size),
+              30 * 20'031);
+
+    /// setup: [2, 8, 4] NPUs, and the time of the slowest of a step's sends
+    const auto topology = construct_topology(NetworkParser("../../input/Ring_FullyConnected_Switch.yml"));
+    const auto npus_count = topology->get_npus_count();
+    const auto size = 64 * chunk_size;
+    const auto step_time = [&](const auto partner, const ChunkSize step_chunk_size) {
+        auto time = EventTime{0};
+        for (auto npu = 0; npu < npus_count; npu++) {
+            time = std::max(time, topology->send(npu, partner(npu), step_chunk_size));
+        }
+        return time;
+    };
+
+    /// test: hierarchical runs a ring within each dimension, shrinking then growing the buffer
+    const auto hierarchical_time = 2 * (topology->send(0, 1, size / 2) + 7 * topology->send(0, 2, size / 16) +
+                                        3 * topology->send(0, 16, size / 64));
+    EXPECT_EQ(topology->estimate_collective(CollectiveType::AllReduce, CollectiveAlgorithm::Hierarchical, size),
+              hierarchical_time);
+
+    /// test: flat algorithms match costing every send of every step
+    auto ring_all_to_all_time = EventTime{0};
+    for (auto offset = 1; offset < npus_count; offset++) {
+        ring_all_to_all_time += step_time([&](const int npu) { return (npu + offset) % npus_count; }, size / 64);
+    }
+    EXPECT_EQ(topology->estimate_collective(CollectiveType::AllToAll, CollectiveAlgorithm::Ring, size),
+              ring_all_to_all_time);
+
+    auto halving_doubling_time = EventTime{0};
+    for (auto distance = 1; distance < npus_count; distance <<= 1) {
+        halving_doubling_time += step_time([&](const int npu) { return npu ^ distance; }, size / 64 * distance);
+    }
+    EXPECT_EQ(topology->estimate_collective(CollectiveType::AllGather, CollectiveAlgorithm::HalvingDoubling, size),
+              halving_doubling_time);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, SendBatch) {
+    /// setup: every basic topology, a unidirectional ring and a multi-dimensional topology
+    auto topologies = std::vector<std::shared_ptr<Topology>>();
+    for (const auto* const input : {"Ring", "FullyConnected", "Switch", "Ring_FullyConnected_Switch"}) {
+        topologies.push_back(construct_topology(NetworkParser(std::string("../../input/") + input + ".yml")));
+    }
+    topologies.push_back(std::make_shared<Ring>(8, 50, 500, false));
+
+    for (const auto& topology : topologies) {
+        /// setup: every pair of NPUs with a few chunk sizes, enough chunks to be split across threads
+        const auto npus_count = topology->get_npus_count();
+        auto srcs = std::vector<DeviceId>();
+        auto dests = std::vector<DeviceId>();
+        auto chunk_sizes = std::vector<ChunkSize>();
+        while (srcs.size() < 300'000) {
+            for (auto src = 0; src < npus_count; src++) {
+                for (auto dest = 0; dest < npus_count; dest++) {
+                    if (src != dest) {
+                        srcs.push_back(src);
+                        dests.push_back(dest);
+                        chunk_sizes.push_back(chunk_size + srcs.size() % 1'000);
+                    }
+                }
+            }
+        }
+
+        /// test: the batch matches a send per chunk, whether split across threads or not
+        for (const auto threads_count : {1, 4}) {
+            auto delays = std::vector<EventTime>();
+            topology->send_batch(srcs, dests, chunk_sizes, delays, threads_count);
+            ASSERT_EQ(delays.size(), srcs.size());
+            for (auto i = size_t{0}; i < srcs.size(); i++) {
+                ASSERT_EQ(delays[i], topology->send(srcs[i], dests[i], chunk_sizes[i]));
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, StaticMultiDimTopology) {
+    /// setup: the same [2, 8, 4] shape, with building blocks known at compile time or at runtime
+    const auto topology = construct_topology(NetworkParser("../../input/Ring_FullyConnected_Switch.yml"));
+    ASSERT_NE(std::dynamic_pointer_cast<RingFullyConnectedSwitch>(topology), nullptr);
+
+    auto multi_dim_topology = MultiDimTopology();
+    multi_dim_topology.append_dimension(std::make_unique<Ring>(2, 200, 50));
+    multi_dim_topology.append_dimension(std::make_unique<FullyConnected>(8, 100, 500));
+    multi_dim_topology.append_dimension(std::make_unique<Switch>(4, 50, 2'000));
+
+    /// test: every send matches
+    const auto npus_count = topology->get_npus_count();
+    ASSERT_EQ(npus_count, multi_dim_topology.get_npus_count());
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                ASSERT_EQ(topology->send(src, dest, chunk_size), multi_dim_topology.send(src, dest, chunk_size));
+            }
+        }
+    }
+
+    /// test: collectives, costed with sends within a dimension, match
+    EXPECT_EQ(topology->estimate_collective(CollectiveType::AllReduce, CollectiveAlgorithm::Hierarchical, chunk_size),
+              multi_dim_topology.estimate_collective(CollectiveType::AllReduce, CollectiveAlgorithm::Hierarchical,
+                                                     chunk_size));
+}
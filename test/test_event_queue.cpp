@@ -0,0 +1,227 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+/// number of global operator new calls so far
+static size_t allocations_count = 0;
+
+void* operator new(const size_t size) {
+    allocations_count++;
+    if (auto* const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+class TestEventQueue : public ::testing::TestWithParam<EventSchedulerPolicy> {
+  protected:
+    void SetUp() override {
+        event_queue = std::make_shared<EventQueue>(GetParam());
+        invoked.clear();
+        proceeds_count = 0;
+    }
+
+    /// invoked events, as (proceed index, event id) pairs
+    static std::vector<std::pair<int, int>> invoked;
+
+    /// number of proceed() calls so far
+    static int proceeds_count;
+
+    std::shared_ptr<EventQueue> event_queue;
+
+    static void callback(void* const arg) {
+        const auto event_id = static_cast<int>(reinterpret_cast<intptr_t>(arg));
+        invoked.emplace_back(proceeds_count, event_id);
+    }
+
+    static void* event_arg(const int event_id) {
+        return reinterpret_cast<void*>(static_cast<intptr_t>(event_id));
+    }
+
+    void run() {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+            proceeds_count++;
+        }
+    }
+};
+
+std::vector<std::pair<int, int>> TestEventQueue::invoked;
+int TestEventQueue::proceeds_count;
+
+TEST_P(TestEventQueue, SameTimestampGroupedInFifoOrder) {
+    /// schedule events out of order, with duplicated timestamps
+    event_queue->schedule_event(30, callback, event_arg(0));
+    event_queue->schedule_event(10, callback, event_arg(1));
+    event_queue->schedule_event(30, callback, event_arg(2));
+    event_queue->schedule_event(20, callback, event_arg(3));
+    event_queue->schedule_event(10, callback, event_arg(4));
+    event_queue->schedule_event(30, callback, event_arg(5));
+
+    /// run
+    run();
+
+    /// test: one proceed per timestamp, FIFO within a timestamp
+    const auto expected = std::vector<std::pair<int, int>>{{0, 1}, {0, 4}, {1, 3}, {2, 0}, {2, 2}, {2, 5}};
+    EXPECT_EQ(invoked, expected);
+    EXPECT_EQ(event_queue->get_current_time(), 30);
+}
+
+TEST_P(TestEventQueue, EventAtCurrentTimeRunsInNextProceed) {
+    /// an event scheduling another event at the current time
+    struct Arg {
+        EventQueue* event_queue;
+    };
+    static auto reschedule = [](void* const arg) {
+        auto* const event_queue = static_cast<Arg*>(arg)->event_queue;
+        invoked.emplace_back(proceeds_count, -1);
+        event_queue->schedule_event(event_queue->get_current_time(), callback, event_arg(1));
+    };
+    auto arg = Arg{event_queue.get()};
+    event_queue->schedule_event(5, reschedule, &arg);
+    event_queue->schedule_event(5, callback, event_arg(0));
+
+    /// run
+    run();
+
+    /// test
+    const auto expected = std::vector<std::pair<int, int>>{{0, -1}, {0, 0}, {1, 1}};
+    EXPECT_EQ(invoked, expected);
+    EXPECT_EQ(event_queue->get_current_time(), 5);
+}
+
+TEST_P(TestEventQueue, ManyRandomEvents) {
+    /// schedule a large number of events with random timestamps, forcing resizes
+    auto rng = std::mt19937_64(42);
+    auto time_dist = std::uniform_int_distribution<EventTime>(0, 1'000'000);
+    auto expected = std::vector<std::pair<EventTime, int>>();
+    for (auto i = 0; i < 5'000; i++) {
+        const auto event_time = time_dist(rng) / 16 * 16;
+        event_queue->schedule_event(event_time, callback, event_arg(i));
+        expected.emplace_back(event_time, i);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    /// run
+    auto times = std::vector<EventTime>();
+    auto previous_invoked = size_t{0};
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+        for (auto i = previous_invoked; i < invoked.size(); i++) {
+            times.push_back(event_queue->get_current_time());
+        }
+        previous_invoked = invoked.size();
+    }
+
+    /// test: globally ordered by time, FIFO within a timestamp
+    ASSERT_EQ(invoked.size(), expected.size());
+    for (auto i = size_t{0}; i < expected.size(); i++) {
+        EXPECT_EQ(times[i], expected[i].first);
+        EXPECT_EQ(invoked[i].second, expected[i].second);
+    }
+}
+
+/// argument of spawn_events()
+struct SpawnArg {
+    EventQueue* event_queue;
+    std::mt19937_64 rng;
+    int scheduled_count;
+    int invoked_count;
+};
+
+/// event which schedules two follow-up events, possibly at the current time
+static void spawn_events(void* const ptr) {
+    auto* const arg = static_cast<SpawnArg*>(ptr);
+    const auto current_time = arg->event_queue->get_current_time();
+    arg->invoked_count++;
+    if (arg->scheduled_count >= 50'000) {
+        return;
+    }
+    for (auto i = 0; i < 2; i++) {
+        const auto event_time = current_time + (arg->rng() % 4) * (arg->rng() % 1'000);
+        arg->scheduled_count++;
+        arg->event_queue->schedule_event(event_time, spawn_events, arg);
+    }
+}
+
+TEST_P(TestEventQueue, EventsScheduledWhileRunning) {
+    /// each event schedules follow-up events, some at the current time
+    auto arg = SpawnArg{event_queue.get(), std::mt19937_64(7), 0, 0};
+    event_queue->schedule_event(0, spawn_events, &arg);
+
+    /// run, recording the time each event is invoked
+    auto invoked_times = std::vector<EventTime>();
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+        invoked_times.resize(arg.invoked_count, event_queue->get_current_time());
+    }
+
+    /// test: time never goes backwards, and every scheduled event is invoked exactly once
+    EXPECT_TRUE(std::is_sorted(invoked_times.begin(), invoked_times.end()));
+    EXPECT_EQ(arg.invoked_count, arg.scheduled_count + 1);
+}
+
+/// argument of hold_event()
+struct HoldArg {
+    EventQueue* event_queue;
+    std::mt19937_64 rng;
+};
+
+/// event which reschedules itself, keeping the number of pending events constant
+static void hold_event(void* const ptr) {
+    auto* const arg = static_cast<HoldArg*>(ptr);
+    const auto event_time = arg->event_queue->get_current_time() + arg->rng() % 10'000;
+    arg->event_queue->schedule_event(event_time, hold_event, arg);
+}
+
+TEST_P(TestEventQueue, SteadyStateDoesNotAllocate) {
+    /// keep 4'096 events pending, each rescheduling itself
+    auto arg = HoldArg{event_queue.get(), std::mt19937_64(3)};
+    for (auto i = 0; i < 4'096; i++) {
+        event_queue->schedule_event(arg.rng() % 10'000, hold_event, &arg);
+    }
+
+    /// warm up, so that the pools grow to the peak number of events
+    for (auto i = 0; i < 100'000; i++) {
+        event_queue->proceed();
+    }
+
+    /// run the steady state
+    const auto allocations_before = allocations_count;
+    for (auto i = 0; i < 100'000; i++) {
+        event_queue->proceed();
+    }
+
+    /// test: no heap allocation in the steady state
+    EXPECT_EQ(allocations_count, allocations_before);
+}
+
+INSTANTIATE_TEST_SUITE_P(EventSchedulerPolicies,
+                         TestEventQueue,
+                         ::testing::Values(EventSchedulerPolicy::List,
+                                           EventSchedulerPolicy::BinaryHeap,
+                                           EventSchedulerPolicy::RadixHeap,
+                                           EventSchedulerPolicy::Calendar));
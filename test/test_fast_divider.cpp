@@ -0,0 +1,70 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/FastDivider.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+/// check divide and modulo against the hardware division for the given dividends
+static void expect_matches_division(const uint32_t divisor, const std::vector<uint32_t>& dividends) {
+    const auto divider = FastDivider(divisor);
+    ASSERT_EQ(divider.get_divisor(), divisor);
+    for (const auto dividend : dividends) {
+        EXPECT_EQ(divider.divide(dividend), dividend / divisor) << dividend << " / " << divisor;
+        EXPECT_EQ(divider.modulo(dividend), dividend % divisor) << dividend << " % " << divisor;
+    }
+}
+
+/// dividends covering small values, values around multiples of the divisor and values near UINT32_MAX
+static std::vector<uint32_t> dividends_for(const uint32_t divisor) {
+    auto dividends = std::vector<uint32_t>();
+    for (auto dividend = uint32_t{0}; dividend < 1'024; dividend++) {
+        dividends.push_back(dividend);
+    }
+    for (const auto multiple : {uint64_t{1}, uint64_t{2}, uint64_t{1'000}, uint64_t{UINT32_MAX / divisor}}) {
+        const auto product = multiple * divisor;
+        for (const auto offset : {-1, 0, 1}) {
+            if (product + offset <= UINT32_MAX) {
+                dividends.push_back(static_cast<uint32_t>(product + offset));
+            }
+        }
+    }
+    for (auto offset = uint32_t{0}; offset < 1'024; offset++) {
+        dividends.push_back(UINT32_MAX - offset);
+    }
+
+    auto rng = std::mt19937(divisor);
+    for (auto i = 0; i < 1'024; i++) {
+        dividends.push_back(static_cast<uint32_t>(rng()));
+    }
+    return dividends;
+}
+
+TEST(TestFastDivider, DivisorOne) {
+    expect_matches_division(1, dividends_for(1));
+}
+
+TEST(TestFastDivider, SmallDivisors) {
+    for (auto divisor = uint32_t{2}; divisor <= 1'024; divisor++) {
+        expect_matches_division(divisor, dividends_for(divisor));
+    }
+}
+
+TEST(TestFastDivider, PowersOfTwo) {
+    for (auto shift = 0; shift < 32; shift++) {
+        const auto divisor = uint32_t{1} << shift;
+        expect_matches_division(divisor, dividends_for(divisor));
+    }
+}
+
+TEST(TestFastDivider, LargeDivisors) {
+    for (const auto divisor : {UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 2 + 1, 1'000'000'007u}) {
+        expect_matches_division(divisor, dividends_for(divisor));
+    }
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SimulationServer.h"
+#include "common/Type.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+using namespace NetworkAnalytical;
+
+class TestSimulationServer : public ::testing::Test {
+  protected:
+    SimulationServer server;
+
+    /// answer a request, parsing the JSON response
+    YAML::Node request(const std::string& line) {
+        auto quit = false;
+        const auto response = server.answer(line, quit);
+        EXPECT_FALSE(quit) << line;
+        return YAML::Load(response);
+    }
+
+    /// check that a response reports an error
+    static void expect_error(const YAML::Node& response, const std::string& message) {
+        ASSERT_TRUE(response["ok"]);
+        EXPECT_FALSE(response["ok"].as<bool>());
+        ASSERT_TRUE(response["error"]);
+        EXPECT_NE(response["error"].as<std::string>().find(message), std::string::npos)
+            << response["error"].as<std::string>();
+    }
+};
+
+TEST_F(TestSimulationServer, LoadSendCollective) {
+    /// setup: a congestion_unaware and a congestion_aware topology
+    auto response = request(R"({"id": 1, "op": "load", "name": "unaware", "backend": "congestion_unaware",
+                                "network": {"topology": ["Ring"], "npus_count": [8],
+                                            "bandwidth": [50], "latency": [500]}})");
+    EXPECT_EQ(response["id"].as<int>(), 1);
+    EXPECT_EQ(response["npus_count"].as<int>(), 8);
+    response = request(R"({"op": "load", "name": "aware", "backend": "congestion_aware",
+                           "path": "../../input/Ring.yml"})");
+    EXPECT_EQ(response["npus_count"].as<int>(), 16);
+
+    /// test: a single chunk crosses three hops, forwarded as a whole at each hop on congestion_aware
+    const auto unaware_send = request(R"({"op": "send", "topology": "unaware", "chunks": [[1, 4, 1048576]]})");
+    const auto aware_send = request(R"({"op": "send", "topology": "aware", "chunks": [[1, 4, 1048576]]})");
+    EXPECT_EQ(unaware_send["delays"].as<std::vector<EventTime>>(), std::vector<EventTime>{3 * 500 + 19'531});
+    EXPECT_EQ(aware_send["delays"].as<std::vector<EventTime>>(), std::vector<EventTime>{60'093});
+    EXPECT_EQ(aware_send["finish_time"].as<EventTime>(), 60'093);
+
+    /// test: contending chunks queue up on congestion_aware
+    response = request(R"({"op": "send", "topology": "aware", "chunks": [[1, 4, 1048576], [1, 4, 1048576]]})");
+    EXPECT_EQ(response["finish_time"].as<EventTime>(), 60'093 + 19'531);
+
+    /// test: collectives run one at a time
+    response = request(R"({"op": "collective", "topology": "aware",
+                           "collectives": [{"type": "AllGather", "algorithm": "Ring", "size": 1048576},
+                                           {"type": "AllGather", "algorithm": "Ring", "size": 1048576}]})");
+    const auto times = response["times"].as<std::vector<EventTime>>();
+    ASSERT_EQ(times.size(), 2);
+    EXPECT_GT(times[0], 0);
+    EXPECT_EQ(times[0], times[1]);
+    response = request(R"({"op": "collective", "topology": "unaware",
+                           "collectives": [{"type": "AllReduce", "algorithm": "Ring", "size": 1048576}]})");
+    EXPECT_EQ(response["times"].as<std::vector<EventTime>>().size(), 1);
+}
+
+TEST_F(TestSimulationServer, RepeatedCollectives) {
+    /// setup: a congestion_aware topology and the time of a single collective
+    request(R"({"op": "load", "name": "ring", "backend": "congestion_aware",
+                "network": {"topology": ["Ring"], "npus_count": [8], "bandwidth": [50], "latency": [500]}})");
+    const auto collective = R"({"op": "collective", "topology": "ring",
+                                "collectives": [{"type": "AllReduce", "algorithm": "Ring", "size": 65536}]})";
+    const auto times = request(collective)["times"].as<std::vector<EventTime>>();
+    ASSERT_EQ(times.size(), 1);
+    EXPECT_GT(times[0], 0);
+
+    /// test: many queries on the same topology each take the same time
+    for (auto i = 0; i < 1'000; i++) {
+        ASSERT_EQ(request(collective)["times"].as<std::vector<EventTime>>(), times) << "query " << i;
+    }
+}
+
+TEST_F(TestSimulationServer, SurvivesInvalidRequests) {
+    /// setup: a warm topology
+    request(R"({"op": "load", "name": "ring", "backend": "congestion_unaware",
+                "network": {"topology": ["Ring"], "npus_count": [8], "bandwidth": [50], "latency": [500]}})");
+    const auto send = R"({"op": "send", "topology": "ring", "chunks": [[1, 4, 1048576]]})";
+    const auto delays = request(send)["delays"].as<std::vector<EventTime>>();
+
+    /// test: invalid requests are answered with an error
+    expect_error(request(R"({"op": "send", "topology": )"), "");
+    expect_error(request(R"([1, 2, 3])"), "request should be an object");
+    expect_error(request(R"({"op": "launch"})"), "unknown op");
+    expect_error(request(R"({"op": "send", "topology": "mesh", "chunks": []})"), "unknown topology");
+    expect_error(request(R"({"op": "send", "topology": "ring", "chunks": [[1, 1, 1048576]]})"), "invalid src");
+    expect_error(request(R"({"op": "collective", "topology": "ring",
+                             "collectives": [{"type": "Broadcast", "algorithm": "Ring", "size": 1}]})"),
+                 "unknown collective type");
+
+    /// test: invalid network configs are answered with an error
+    expect_error(request(R"({"op": "load", "name": "ring", "backend": "congestion_unaware",
+                             "network": {"topology": ["Ring"], "npus_count": [8]}})"),
+                 "length of bandwidth");
+    expect_error(request(R"({"op": "load", "name": "ring", "backend": "congestion_aware",
+                             "network": {"topology": ["Torus"], "npus_count": [8],
+                                         "bandwidth": [50], "latency": [500]}})"),
+                 "Torus not supported");
+    expect_error(request(R"({"op": "load", "name": "ring", "backend": "congestion_unaware",
+                             "network": {"topology": ["Ring"], "npus_count": [1],
+                                         "bandwidth": [50], "latency": [500]}})"),
+                 "npus_count");
+    expect_error(request(R"({"op": "load", "name": "ring", "backend": "congestion_unaware",
+                             "network": {"topology": ["Reconfig"], "npus_count": [8],
+                                         "bandwidth": [50], "latency": [500]}})"),
+                 "Reconfig");
+    expect_error(request(R"({"op": "load", "name": "ring", "backend": "congestion_unaware",
+                             "path": "missing.yml"})"),
+                 "");
+
+    /// test: the warm topology is still loaded and answers as before
+    EXPECT_EQ(request(send)["delays"].as<std::vector<EventTime>>(), delays);
+}
+
+TEST_F(TestSimulationServer, Serve) {
+    /// test: requests are answered line by line until a quit request
+    auto input = std::istringstream(R"({"id": 1, "op": "unload", "name": "ring"}
+
+{"id": 2, "op": "quit"}
+{"id": 3, "op": "quit"}
+)");
+    auto output = std::ostringstream();
+    EXPECT_TRUE(server.serve(input, output));
+
+    auto responses = std::istringstream(output.str());
+    auto line = std::string();
+    auto lines = std::vector<std::string>();
+    while (std::getline(responses, line)) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 2);
+    expect_error(YAML::Load(lines[0]), "unknown topology");
+    EXPECT_EQ(YAML::Load(lines[1])["id"].as<int>(), 2);
+    EXPECT_TRUE(YAML::Load(lines[1])["ok"].as<bool>());
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SweepDriver.h"
+#include "common/Type.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+TEST(TestSweepDriver, ThreadsCountIndependent) {
+    /// setup: a grid of 16 congestion_aware configurations, with a base config next to the sweep file
+    const auto base_path = ::testing::TempDir() + "sweep_base.yml";
+    const auto sweep_path = ::testing::TempDir() + "sweep.yml";
+    {
+        auto base_file = std::ofstream(base_path);
+        base_file << "topology: [ Ring ]\n"
+                  << "npus_count: [ 8 ]\n"
+                  << "bandwidth: [ 50.0 ]\n"
+                  << "latency: [ 500.0 ]\n";
+        auto sweep_file = std::ofstream(sweep_path);
+        sweep_file << "base: sweep_base.yml\n"
+                   << "backend: congestion_aware\n"
+                   << "sweep:\n"
+                   << "  topology: [ [ Ring ], [ Switch ] ]\n"
+                   << "  npus_count: [ [ 4 ], [ 8 ] ]\n"
+                   << "  bandwidth: [ [ 50.0 ], [ 100.0 ] ]\n"
+                   << "  latency: [ [ 500.0 ], [ 1000.0 ] ]\n"
+                   << "workload: { type: traffic, chunks_count: 64, size: 65536 }\n"
+                   << "seed: 7\n";
+    }
+    const auto sweep = read_sweep(sweep_path);
+    std::remove(base_path.c_str());
+    std::remove(sweep_path.c_str());
+    ASSERT_EQ(sweep.get_configs_count(), 16);
+
+    /// test: every configuration takes some time
+    const auto times = evaluate_sweep(sweep, 1);
+    ASSERT_EQ(times.size(), 16);
+    EXPECT_TRUE(std::all_of(times.begin(), times.end(), [](const EventTime time) { return time > 0; }));
+
+    /// test: results don't depend on the number of threads
+    auto output = std::ostringstream();
+    write_sweep_results(output, sweep, times);
+    for (const auto threads_count : {2, 4, 16}) {
+        const auto parallel_times = evaluate_sweep(sweep, threads_count);
+        EXPECT_EQ(parallel_times, times) << threads_count << " threads";
+
+        auto parallel_output = std::ostringstream();
+        write_sweep_results(parallel_output, sweep, parallel_times);
+        EXPECT_EQ(parallel_output.str(), output.str()) << threads_count << " threads";
+    }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Trace.h"
+#include "common/Type.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace NetworkAnalytical;
+
+TEST(TestTrace, RingBufferRoundTrip) {
+    /// setup: a buffer of 4 records, given 6
+    auto buffer = TraceBuffer(4);
+    for (auto i = 0; i < 6; i++) {
+        const auto args = {to_trace_arg(i), to_trace_arg(i + 1), to_trace_arg(100), to_trace_arg(1)};
+        auto record = TraceRecord{static_cast<EventTime>(i), {}, TraceEvent::ChunkTransmissionScheduled,
+                                  TraceLevel::Debug, {}};
+        std::copy(args.begin(), args.end(), record.args);
+        buffer.record(record);
+    }
+
+    /// test: the oldest records are overwritten
+    const auto records = buffer.snapshot();
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_EQ(records.front().time, 2);
+    EXPECT_EQ(records.back().time, 5);
+    EXPECT_EQ(buffer.get_dropped_count(), 2);
+
+    /// test: a dumped trace decodes into one line per record
+    const auto trace_path = ::testing::TempDir() + "trace_round_trip.bin";
+    ASSERT_TRUE(buffer.dump(trace_path));
+    auto decoded = std::ostringstream();
+    auto trace_file = std::ifstream(trace_path, std::ios::binary);
+    const auto decode_succeeded = decode_trace(trace_file, decoded);
+    trace_file.close();
+    std::remove(trace_path.c_str());
+    ASSERT_TRUE(decode_succeeded);
+
+    const auto text = decoded.str();
+    EXPECT_NE(text.find("5 [Link/Debug] ChunkTransmissionScheduled src=5 dest=6 size=100 hop=1\n"),
+              std::string::npos);
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 5);
+}
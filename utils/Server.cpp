@@ -0,0 +1,156 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SimulationServer.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/**
+ * FdStreamBuf is a buffered stream over a file descriptor, e.g., a connected socket.
+ */
+class FdStreamBuf : public std::streambuf {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param fd file descriptor to read from and write to, kept open
+     */
+    explicit FdStreamBuf(const int fd) noexcept : fd(fd) {
+        setg(input_buffer, input_buffer, input_buffer);
+        setp(output_buffer, output_buffer + sizeof(output_buffer));
+    }
+
+    /**
+     * Destructor, writing what is left in the output buffer.
+     */
+    ~FdStreamBuf() noexcept override {
+        sync();
+    }
+
+  protected:
+    int_type underflow() override {
+        const auto count = read(fd, input_buffer, sizeof(input_buffer));
+        if (count <= 0) {
+            return traits_type::eof();
+        }
+
+        setg(input_buffer, input_buffer, input_buffer + count);
+        return traits_type::to_int_type(input_buffer[0]);
+    }
+
+    int_type overflow(const int_type character) override {
+        if (sync() != 0) {
+            return traits_type::eof();
+        }
+
+        if (!traits_type::eq_int_type(character, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    int sync() override {
+        for (auto* begin = pbase(); begin < pptr();) {
+            const auto count = write(fd, begin, pptr() - begin);
+            if (count <= 0) {
+                return -1;
+            }
+            begin += count;
+        }
+
+        setp(output_buffer, output_buffer + sizeof(output_buffer));
+        return 0;
+    }
+
+  private:
+    /// file descriptor
+    int fd;
+
+    /// bytes read but not consumed yet
+    char input_buffer[1 << 16];
+
+    /// bytes not written yet
+    char output_buffer[1 << 16];
+};
+
+/**
+ * Serve clients connecting to a Unix domain socket, one at a time, until a quit request.
+ *
+ * @param server server answering the requests
+ * @param path path of the socket
+ * @return exit code
+ */
+int serve_socket(SimulationServer& server, const std::string& path) noexcept {
+    auto address = sockaddr_un{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "[Error] (network/analytical/server) " << "socket path too long: " << path << std::endl;
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const auto listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd, 1) != 0) {
+        std::cerr << "[Error] (network/analytical/server) " << "cannot listen on " << path << ": "
+                  << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    auto quit = false;
+    while (!quit) {
+        const auto fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        {
+            auto stream_buf = FdStreamBuf(fd);
+            auto stream = std::iostream(&stream_buf);
+            quit = server.serve(stream, stream);
+        }
+        close(fd);
+    }
+
+    close(listen_fd);
+    unlink(path.c_str());
+    return 0;
+}
+
+}  // namespace
+
+/**
+ * Run a SimulationServer over stdin/stdout, or over a Unix domain socket.
+ *
+ * Usage: Analytical_Server [--socket <path>]
+ */
+int main(const int argc, const char* const argv[]) {
+    auto server = SimulationServer();
+
+    if (argc == 1) {
+        std::ios::sync_with_stdio(false);
+        server.serve(std::cin, std::cout);
+        return 0;
+    }
+
+    if (argc == 3 && std::string(argv[1]) == "--socket") {
+        return serve_socket(server, argv[2]);
+    }
+
+    std::cerr << "Usage: " << argv[0] << " [--socket <path>]" << std::endl;
+    return -1;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SweepDriver.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+/**
+ * Evaluate every configuration of a sweep, and write the results as a columnar JSON file:
+ * one array per column, holding one row per configuration in sweep order.
+ * See read_sweep for the format of the sweep file.
+ * Results only depend on the sweep file, whatever the number of threads.
+ *
+ * Usage: Analytical_Sweep <sweep file> <output file> [threads count]
+ */
+int main(const int argc, const char* const argv[]) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <sweep file> <output file> [threads count]" << std::endl;
+        return -1;
+    }
+
+    const auto sweep = read_sweep(argv[1]);
+
+    const auto threads_count = (argc == 4) ? std::atoi(argv[3])
+                                           : std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    if (threads_count <= 0) {
+        std::cerr << "[Error] (network/analytical/sweep) " << "threads count should be positive" << std::endl;
+        return -1;
+    }
+
+    auto output = std::ofstream(argv[2]);
+    if (!output) {
+        std::cerr << "[Error] (network/analytical/sweep) " << "cannot open " << argv[2] << std::endl;
+        return -1;
+    }
+
+    // evaluate the configurations, and write the results
+    const auto times = evaluate_sweep(sweep, threads_count);
+    write_sweep_results(output, sweep, times);
+
+    return 0;
+}
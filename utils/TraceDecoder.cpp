@@ -0,0 +1,35 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Trace.h"
+#include <fstream>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+/**
+ * Decode a binary trace file written by TraceBuffer::dump, one line of text per record.
+ *
+ * Usage: Analytical_Trace_Decoder <trace file>
+ */
+int main(const int argc, const char* const argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+        return -1;
+    }
+
+    auto trace_file = std::ifstream(argv[1], std::ios::binary);
+    if (!trace_file) {
+        std::cerr << "[Error] (network/analytical/trace) " << "cannot open " << argv[1] << std::endl;
+        return -1;
+    }
+
+    if (!decode_trace(trace_file, std::cout)) {
+        std::cerr << "[Error] (network/analytical/trace) " << argv[1] << " is not a valid trace file" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SimulationServer.h"
+#include "common/CollectiveParser.h"
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/CollectiveEngine.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_unaware/Helper.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+using namespace NetworkAnalytical;
+
+namespace Aware = NetworkAnalyticalCongestionAware;
+namespace Unaware = NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/**
+ * Error in a request, reported back to the client instead of terminating the server.
+ */
+struct RequestError {
+    /// description of the error
+    std::string message;
+};
+
+/**
+ * Quote a string as a JSON string.
+ *
+ * @param text string to quote
+ * @return quoted string
+ */
+std::string quote(const std::string& text) noexcept {
+    auto quoted = std::string("\"");
+    for (const auto character : text) {
+        if (character == '"' || character == '\\') {
+            quoted += '\\';
+            quoted += character;
+        } else if (static_cast<unsigned char>(character) < 0x20) {
+            quoted += ' ';
+        } else {
+            quoted += character;
+        }
+    }
+    return quoted + "\"";
+}
+
+/**
+ * Get a required field of a request.
+ *
+ * @param request request
+ * @param key name of the field
+ * @return the field
+ */
+YAML::Node field(const YAML::Node& request, const std::string& key) {
+    const auto node = request[key];
+    if (!node) {
+        throw RequestError{"missing field \"" + key + "\""};
+    }
+    return node;
+}
+
+/**
+ * Arrival of a chunk of a send query on a congestion_aware topology.
+ */
+struct ChunkArrival {
+    /// event queue driving the topology
+    const EventQueue* event_queue;
+
+    /// where to record the arrival time
+    EventTime* arrival_time;
+};
+
+/**
+ * Record the arrival time of a chunk.
+ *
+ * @param arg ChunkArrival of the chunk
+ */
+void record_chunk_arrival(void* const arg) noexcept {
+    const auto* const chunk_arrival = static_cast<ChunkArrival*>(arg);
+    *chunk_arrival->arrival_time = chunk_arrival->event_queue->get_current_time();
+}
+
+}  // namespace
+
+bool SimulationServer::serve(std::istream& input, std::ostream& output) noexcept {
+    auto line = std::string();
+    while (std::getline(input, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        auto quit = false;
+        output << answer(line, quit) << std::endl;
+        if (quit) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string SimulationServer::answer(const std::string& line, bool& quit) noexcept {
+    auto response = std::string("{");
+    try {
+        const auto request = YAML::Load(line);
+        if (!request.IsMap()) {
+            throw RequestError{"request should be an object"};
+        }
+        if (request["id"]) {
+            response += "\"id\": " + std::to_string(request["id"].as<int64_t>()) + ", ";
+        }
+
+        const auto op = field(request, "op").as<std::string>();
+        if (op == "load") {
+            response += load(request);
+        } else if (op == "send") {
+            response += send(request);
+        } else if (op == "collective") {
+            response += run_collectives(request);
+        } else if (op == "unload") {
+            if (topologies.erase(field(request, "name").as<std::string>()) == 0) {
+                throw RequestError{"unknown topology"};
+            }
+            response += "\"ok\": true";
+        } else if (op == "quit") {
+            quit = true;
+            response += "\"ok\": true";
+        } else {
+            throw RequestError{"unknown op " + op};
+        }
+    } catch (const RequestError& e) {
+        response += "\"ok\": false, \"error\": " + quote(e.message);
+    } catch (const NetworkConfigError& e) {
+        response += "\"ok\": false, \"error\": " + quote(e.what());
+    } catch (const YAML::Exception& e) {
+        response += "\"ok\": false, \"error\": " + quote(e.what());
+    }
+
+    return response + "}";
+}
+
+std::string SimulationServer::load(const YAML::Node& request) {
+    const auto name = field(request, "name").as<std::string>();
+    const auto backend = field(request, "backend").as<std::string>();
+    if (backend != "congestion_unaware" && backend != "congestion_aware") {
+        throw RequestError{"unknown backend " + backend};
+    }
+
+    // the network config is given inline, or as the path of a yml file
+    const auto network_config = request["network"] ? request["network"]
+                                                   : YAML::LoadFile(field(request, "path").as<std::string>());
+    if (!network_config.IsMap() || !network_config["topology"]) {
+        throw RequestError{"network config should have a topology"};
+    }
+    const auto network_parser = NetworkParser(network_config);
+    for (const auto building_block : network_parser.get_topologies_per_dim()) {
+        if (building_block == TopologyBuildingBlock::Reconfig) {
+            throw RequestError{"Reconfig topologies aren't supported by " + backend};
+        }
+    }
+
+    auto topology = LoadedTopology();
+    topology.congestion_aware = (backend == "congestion_aware");
+    if (topology.congestion_aware) {
+        if (network_parser.get_dims_count() != 1) {
+            throw RequestError{"congestion_aware supports 1-dim topologies only"};
+        }
+        topology.event_queue = std::make_shared<EventQueue>();
+        const auto context = std::make_shared<Aware::SimulationContext>(topology.event_queue);
+        topology.aware_topology = Aware::construct_topology(network_parser, context);
+        topology.npus_count = topology.aware_topology->get_npus_count();
+    } else {
+        topology.unaware_topology = Unaware::construct_topology(network_parser);
+        topology.npus_count = topology.unaware_topology->get_npus_count();
+    }
+
+    const auto npus_count = topology.npus_count;
+    topologies.insert_or_assign(name, std::move(topology));
+    return "\"npus_count\": " + std::to_string(npus_count);
+}
+
+SimulationServer::LoadedTopology& SimulationServer::find_topology(const YAML::Node& request) {
+    const auto topology = topologies.find(field(request, "topology").as<std::string>());
+    if (topology == topologies.end()) {
+        throw RequestError{"unknown topology"};
+    }
+    return topology->second;
+}
+
+std::string SimulationServer::send(const YAML::Node& request) {
+    auto& topology = find_topology(request);
+
+    // parse and check the chunks
+    auto srcs = std::vector<DeviceId>();
+    auto dests = std::vector<DeviceId>();
+    auto chunk_sizes = std::vector<ChunkSize>();
+    for (const auto& chunk : field(request, "chunks")) {
+        if (!chunk.IsSequence() || chunk.size() != 3) {
+            throw RequestError{"chunks should be [src, dest, size] triples"};
+        }
+        const auto src = chunk[0].as<DeviceId>();
+        const auto dest = chunk[1].as<DeviceId>();
+        const auto chunk_size = chunk[2].as<ChunkSize>();
+        if (src < 0 || src >= topology.npus_count || dest < 0 || dest >= topology.npus_count || src == dest) {
+            throw RequestError{"invalid src and dest " + std::to_string(src) + ", " + std::to_string(dest)};
+        }
+        if (chunk_size == 0) {
+            throw RequestError{"chunk size should be positive"};
+        }
+        srcs.push_back(src);
+        dests.push_back(dest);
+        chunk_sizes.push_back(chunk_size);
+    }
+
+    auto delays = std::vector<EventTime>();
+    if (topology.congestion_aware) {
+        // inject every chunk at the current time and simulate until they all arrive
+        const auto start_time = topology.event_queue->get_current_time();
+        delays.resize(srcs.size());
+        auto chunk_arrivals = std::vector<ChunkArrival>(srcs.size());
+        for (auto i = size_t{0}; i < srcs.size(); i++) {
+            chunk_arrivals[i] = ChunkArrival{topology.event_queue.get(), &delays[i]};
+            auto route = topology.aware_topology->cached_route(srcs[i], dests[i]);
+            topology.aware_topology->send(std::make_unique<Aware::Chunk>(chunk_sizes[i], std::move(route),
+                                                                          record_chunk_arrival,
+                                                                          &chunk_arrivals[i]));
+        }
+        while (!topology.event_queue->finished()) {
+            topology.event_queue->proceed();
+        }
+        for (auto& delay : delays) {
+            delay -= start_time;
+        }
+    } else {
+        topology.unaware_topology->send_batch(srcs, dests, chunk_sizes, delays);
+    }
+
+    auto response = std::string("\"delays\": [");
+    for (auto i = size_t{0}; i < delays.size(); i++) {
+        response += (i == 0 ? "" : ", ") + std::to_string(delays[i]);
+    }
+    const auto finish_time = delays.empty() ? EventTime{0} : *std::max_element(delays.begin(), delays.end());
+    return response + "], \"finish_time\": " + std::to_string(finish_time);
+}
+
+std::string SimulationServer::run_collectives(const YAML::Node& request) {
+    auto& topology = find_topology(request);
+
+    // parse and check every collective before running any
+    struct CollectiveQuery {
+        CollectiveType type;
+        CollectiveAlgorithm algorithm;
+        ChunkSize size;
+    };
+    auto queries = std::vector<CollectiveQuery>();
+    for (const auto& collective : field(request, "collectives")) {
+        const auto type_name = field(collective, "type").as<std::string>();
+        const auto algorithm_name = field(collective, "algorithm").as<std::string>();
+        const auto type = parse_collective_type(type_name);
+        if (!type.has_value()) {
+            throw RequestError{"unknown collective type " + type_name};
+        }
+        const auto algorithm = parse_collective_algorithm(algorithm_name);
+        if (!algorithm.has_value()) {
+            throw RequestError{"unknown collective algorithm " + algorithm_name};
+        }
+        const auto query = CollectiveQuery{*type, *algorithm, field(collective, "size").as<ChunkSize>()};
+        const auto npus_count = topology.npus_count;
+        if (query.algorithm == CollectiveAlgorithm::HalvingDoubling && (npus_count & (npus_count - 1)) != 0) {
+            throw RequestError{"HalvingDoubling needs a power-of-two number of NPUs"};
+        }
+        if (query.size == 0) {
+            throw RequestError{"collective size should be positive"};
+        }
+        queries.push_back(query);
+    }
+
+    auto response = std::string("\"times\": [");
+    for (auto i = size_t{0}; i < queries.size(); i++) {
+        const auto& query = queries[i];
+        auto time = EventTime{0};
+        if (topology.congestion_aware) {
+            // the engine keeps every collective it runs, so each query gets its own,
+            // dropped once its events have all been processed
+            auto collective_engine = Aware::CollectiveEngine(topology.aware_topology);
+            const auto collective_id = collective_engine.run(query.type, query.algorithm, query.size);
+            while (!topology.event_queue->finished()) {
+                topology.event_queue->proceed();
+            }
+            time = collective_engine.get_finish_time(collective_id) - collective_engine.get_start_time(collective_id);
+        } else {
+            time = topology.unaware_topology->estimate_collective(query.type, query.algorithm, query.size);
+        }
+        response += (i == 0 ? "" : ", ") + std::to_string(time);
+    }
+    return response + "]";
+}
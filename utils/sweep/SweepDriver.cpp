@@ -0,0 +1,460 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "utils/SweepDriver.h"
+#include "common/CollectiveParser.h"
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/CollectiveEngine.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_unaware/Helper.h"
+#include "reconfigurable/Chunk.h"
+#include "reconfigurable/SimulationContext.h"
+#include "reconfigurable/TopologyManager.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+using namespace NetworkAnalytical;
+
+namespace Aware = NetworkAnalyticalCongestionAware;
+namespace Unaware = NetworkAnalyticalCongestionUnaware;
+namespace Reconfigurable = NetworkAnalyticalReconfigurable;
+
+namespace {
+
+/**
+ * Exit on an invalid sweep file.
+ *
+ * @param message description of the error
+ */
+[[noreturn]] void sweep_error(const std::string& message) noexcept {
+    std::cerr << "[Error] (network/analytical/sweep) " << message << std::endl;
+    std::exit(-1);
+}
+
+/**
+ * Read the values to try for a parameter: the "sweep" entry of the parameter if any,
+ * or else the value of the base configuration.
+ *
+ * @tparam T type of the value of a dimension
+ * @param sweep_node "sweep" entry of the sweep file
+ * @param base_node base network configuration
+ * @param key name of the parameter
+ * @param dims_count number of dimensions every value should have
+ * @param is_valid check of the value of a dimension
+ * @return values to try
+ */
+template <typename T>
+std::vector<std::vector<T>> read_values(const YAML::Node& sweep_node,
+                                        const YAML::Node& base_node,
+                                        const std::string& key,
+                                        const size_t dims_count,
+                                        const std::function<bool(const T&)>& is_valid) {
+    auto values = std::vector<std::vector<T>>();
+    if (sweep_node[key]) {
+        values = sweep_node[key].as<std::vector<std::vector<T>>>();
+    } else if (base_node[key]) {
+        values.push_back(base_node[key].as<std::vector<T>>());
+    }
+
+    if (values.empty()) {
+        sweep_error("no value for " + key);
+    }
+    for (const auto& value : values) {
+        if (value.size() != dims_count) {
+            sweep_error("every value of " + key + " should have " + std::to_string(dims_count) + " dimensions");
+        }
+        if (!std::all_of(value.begin(), value.end(), is_valid)) {
+            sweep_error("invalid value of " + key);
+        }
+    }
+    return values;
+}
+
+/**
+ * Parse and check a sweep file.
+ *
+ * @param path path of the sweep file
+ * @return the sweep
+ * @throws YAML::Exception if the sweep file can't be read
+ */
+Sweep parse_sweep(const std::string& path) {
+    const auto sweep_node = YAML::LoadFile(path);
+    auto sweep = Sweep();
+
+    // the base network config is relative to the sweep file
+    const auto directory = path.substr(0, path.find_last_of('/') + 1);
+    const auto base_path = sweep_node["base"].as<std::string>();
+    const auto base_node = YAML::LoadFile(base_path.front() == '/' ? base_path : directory + base_path);
+
+    sweep.backend = sweep_node["backend"].as<std::string>();
+    if (sweep.backend != "congestion_unaware" && sweep.backend != "congestion_aware" &&
+        sweep.backend != "reconfigurable") {
+        sweep_error("unknown backend " + sweep.backend);
+    }
+
+    // values of each parameter
+    const auto dims_count = base_node["topology"].size();
+    const auto parameters_node = sweep_node["sweep"] ? sweep_node["sweep"] : YAML::Node(YAML::NodeType::Map);
+    const auto reconfigurable = sweep.backend == "reconfigurable";
+    sweep.topology_values = read_values<std::string>(
+        parameters_node, base_node, "topology", dims_count, [reconfigurable](const std::string& topology) {
+            return topology == "Ring" || topology == "FullyConnected" || topology == "Switch" ||
+                   (reconfigurable && topology == "Reconfig");
+        });
+    sweep.npus_count_values = read_values<int>(parameters_node, base_node, "npus_count", dims_count,
+                                               [](const int npus_count) { return npus_count > 1; });
+    sweep.bandwidth_values = read_values<Bandwidth>(parameters_node, base_node, "bandwidth", dims_count,
+                                                    [](const Bandwidth bandwidth) { return bandwidth > 0; });
+    sweep.latency_values = read_values<Latency>(parameters_node, base_node, "latency", dims_count,
+                                                [](const Latency latency) { return latency >= 0; });
+    if (base_node["reconfig_time"]) {
+        const auto reconfig_times = base_node["reconfig_time"].as<std::vector<Latency>>();
+        if (reconfig_times.size() != 1) {
+            sweep_error("reconfig_time should be a single value");
+        }
+        if (reconfig_times.front() < 0) {
+            sweep_error("reconfig_time should be non-negative");
+        }
+        sweep.reconfig_time = reconfig_times.front();
+    }
+    if (sweep.backend != "congestion_unaware" && dims_count != 1) {
+        sweep_error(sweep.backend + " supports 1-dim topologies only");
+    }
+
+    // workload
+    const auto workload_node = sweep_node["workload"];
+    const auto workload = workload_node["type"].as<std::string>();
+    sweep.size = workload_node["size"].as<ChunkSize>();
+    if (sweep.size == 0) {
+        sweep_error("size should be positive");
+    }
+    if (workload == "collective") {
+        if (reconfigurable) {
+            sweep_error("collectives aren't supported by the reconfigurable backend");
+        }
+        const auto collective_type = parse_collective_type(workload_node["collective"].as<std::string>());
+        const auto collective_algorithm = parse_collective_algorithm(workload_node["algorithm"].as<std::string>());
+        if (!collective_type.has_value() || !collective_algorithm.has_value()) {
+            sweep_error("unknown collective or algorithm");
+        }
+        sweep.collective_workload = true;
+        sweep.collective_type = *collective_type;
+        sweep.collective_algorithm = *collective_algorithm;
+
+        // halving-doubling pairs NPUs up, which needs a power-of-two number of them
+        if (sweep.collective_algorithm == CollectiveAlgorithm::HalvingDoubling) {
+            for (const auto& npus_count : sweep.npus_count_values) {
+                auto total_npus_count = 1;
+                for (const auto dim_npus_count : npus_count) {
+                    total_npus_count *= dim_npus_count;
+                }
+                if ((total_npus_count & (total_npus_count - 1)) != 0) {
+                    sweep_error("HalvingDoubling needs a power-of-two number of NPUs");
+                }
+            }
+        }
+    } else if (workload == "traffic") {
+        sweep.chunks_count = workload_node["chunks_count"].as<uint64_t>();
+    } else {
+        sweep_error("unknown workload " + workload);
+    }
+
+    sweep.seed = sweep_node["seed"] ? sweep_node["seed"].as<uint64_t>() : 0;
+    return sweep;
+}
+
+/**
+ * Derive the seed of a configuration from the seed of the sweep (splitmix64),
+ * so that its traffic doesn't depend on which thread evaluates it, or when.
+ *
+ * @param seed seed of the sweep
+ * @param config_index index of the configuration
+ * @return seed of the configuration
+ */
+uint64_t config_seed(const uint64_t seed, const size_t config_index) noexcept {
+    auto state = seed + (config_index + 1) * UINT64_C(0x9E3779B97F4A7C15);
+    state = (state ^ (state >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    state = (state ^ (state >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return state ^ (state >> 31);
+}
+
+/**
+ * Callback of chunks whose arrival doesn't need to be tracked.
+ */
+void ignore_chunk_arrival(void* const) noexcept {}
+
+/**
+ * Range of tasks left to a worker of a work-stealing loop.
+ */
+struct WorkerTasks {
+    /// guards the range
+    std::mutex mutex;
+
+    /// first task left
+    size_t begin = 0;
+
+    /// end of the tasks left
+    size_t end = 0;
+};
+
+/**
+ * Run tasks [0, tasks_count) across threads.
+ *
+ * Each thread starts with a contiguous range of tasks, which it runs in order.
+ * A thread running out of tasks steals the upper half of the range of another thread,
+ * so threads stay busy even when some tasks take much longer than others.
+ *
+ * @param tasks_count number of tasks
+ * @param threads_count number of threads
+ * @param run_task task to run, given its index
+ */
+void run_work_stealing(const size_t tasks_count,
+                       const int threads_count,
+                       const std::function<void(size_t)>& run_task) noexcept {
+    assert(threads_count > 0);
+
+    auto workers_tasks = std::vector<WorkerTasks>(threads_count);
+    for (auto worker = 0; worker < threads_count; worker++) {
+        workers_tasks[worker].begin = tasks_count * worker / threads_count;
+        workers_tasks[worker].end = tasks_count * (worker + 1) / threads_count;
+    }
+
+    const auto run_worker = [&](const int worker) {
+        auto& own_tasks = workers_tasks[worker];
+        while (true) {
+            // run the next task of the own range
+            auto task = tasks_count;
+            {
+                const auto lock = std::lock_guard(own_tasks.mutex);
+                if (own_tasks.begin < own_tasks.end) {
+                    task = own_tasks.begin++;
+                }
+            }
+            if (task < tasks_count) {
+                run_task(task);
+                continue;
+            }
+
+            // out of tasks: steal the upper half of the range of another worker, or stop if every range is empty
+            auto stolen = false;
+            for (auto offset = 1; offset < threads_count && !stolen; offset++) {
+                auto& victim_tasks = workers_tasks[(worker + offset) % threads_count];
+                auto begin = size_t{0};
+                auto end = size_t{0};
+                {
+                    const auto lock = std::lock_guard(victim_tasks.mutex);
+                    if (victim_tasks.begin < victim_tasks.end) {
+                        begin = victim_tasks.begin + (victim_tasks.end - victim_tasks.begin) / 2;
+                        end = victim_tasks.end;
+                        victim_tasks.end = begin;
+                    }
+                }
+                if (begin < end) {
+                    const auto lock = std::lock_guard(own_tasks.mutex);
+                    own_tasks.begin = begin;
+                    own_tasks.end = end;
+                    stolen = true;
+                }
+            }
+            if (!stolen) {
+                return;
+            }
+        }
+    };
+
+    // the calling thread is worker 0
+    auto threads = std::vector<std::thread>();
+    for (auto worker = 1; worker < threads_count; worker++) {
+        threads.emplace_back(run_worker, worker);
+    }
+    run_worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * Write a column of per-dimension values, one row per configuration.
+ *
+ * @tparam T type of the value of a dimension
+ * @param output stream to write to
+ * @param sweep swept configurations
+ * @param value value of a configuration
+ * @param quoted whether the values are strings
+ */
+template <typename T>
+void write_column(std::ostream& output,
+                  const Sweep& sweep,
+                  const std::function<std::vector<T>(const NetworkConfig&)>& value,
+                  const bool quoted) noexcept {
+    output << "[";
+    for (auto config_index = size_t{0}; config_index < sweep.get_configs_count(); config_index++) {
+        const auto dims_values = value(sweep.get_config(config_index));
+        output << (config_index == 0 ? "[" : ", [");
+        for (auto dim = size_t{0}; dim < dims_values.size(); dim++) {
+            output << (dim == 0 ? "" : ", ") << (quoted ? "\"" : "") << dims_values[dim] << (quoted ? "\"" : "");
+        }
+        output << "]";
+    }
+    output << "]";
+}
+
+}  // namespace
+
+Sweep NetworkAnalytical::read_sweep(const std::string& path) {
+    try {
+        return parse_sweep(path);
+    } catch (const YAML::Exception& e) {
+        sweep_error(e.what());
+    }
+}
+
+EventTime NetworkAnalytical::evaluate(const Sweep& sweep, const size_t config_index) noexcept {
+    const auto config = sweep.get_config(config_index);
+    auto network_config = YAML::Node();
+    network_config["topology"] = config.topology;
+    network_config["npus_count"] = config.npus_count;
+    network_config["bandwidth"] = config.bandwidth;
+    network_config["latency"] = config.latency;
+    network_config["reconfig_time"] = std::vector<Latency>{config.reconfig_time};
+    const auto network_parser = NetworkParser(network_config);
+
+    // random traffic: chunks between distinct NPUs, drawn from the seed of the configuration
+    auto npus_count = 1;
+    for (const auto dim_npus_count : config.npus_count) {
+        npus_count *= dim_npus_count;
+    }
+    auto srcs = std::vector<DeviceId>();
+    auto dests = std::vector<DeviceId>();
+    auto random_engine = std::mt19937_64(config_seed(sweep.seed, config_index));
+    for (auto chunk = uint64_t{0}; chunk < sweep.chunks_count; chunk++) {
+        const auto src = static_cast<DeviceId>(random_engine() % npus_count);
+        const auto offset = static_cast<DeviceId>(1 + random_engine() % (npus_count - 1));
+        srcs.push_back(src);
+        dests.push_back((src + offset) % npus_count);
+    }
+
+    if (sweep.backend == "congestion_unaware") {
+        const auto topology = Unaware::construct_topology(network_parser);
+        if (sweep.collective_workload) {
+            return topology->estimate_collective(sweep.collective_type, sweep.collective_algorithm, sweep.size);
+        }
+
+        auto delays = std::vector<EventTime>();
+        topology->send_batch(srcs, dests, std::vector<ChunkSize>(srcs.size(), sweep.size), delays);
+        return delays.empty() ? 0 : *std::max_element(delays.begin(), delays.end());
+    }
+
+    // events refer to the topology, so each backend processes them all before its topology goes out of scope
+    const auto event_queue = std::make_shared<EventQueue>();
+    if (sweep.backend == "congestion_aware") {
+        const auto context = std::make_shared<Aware::SimulationContext>(event_queue);
+        const auto topology = Aware::construct_topology(network_parser, context);
+        if (sweep.collective_workload) {
+            auto collective_engine = Aware::CollectiveEngine(topology);
+            const auto collective_id =
+                collective_engine.run(sweep.collective_type, sweep.collective_algorithm, sweep.size);
+            while (!event_queue->finished()) {
+                event_queue->proceed();
+            }
+            return collective_engine.get_finish_time(collective_id);
+        }
+
+        for (auto i = size_t{0}; i < srcs.size(); i++) {
+            topology->send(std::make_unique<Aware::Chunk>(sweep.size, topology->cached_route(srcs[i], dests[i]),
+                                                          ignore_chunk_arrival, nullptr));
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        return event_queue->get_current_time();
+    }
+
+    // reconfigurable: circuits matching the building block, a Reconfig topology being fully connected
+    const auto& topology = config.topology[0];
+    const auto devices_count = (topology == "Switch") ? npus_count + 1 : npus_count;
+    const auto context = std::make_shared<Reconfigurable::SimulationContext>(event_queue);
+    auto topology_manager = Reconfigurable::TopologyManager(npus_count, devices_count, context);
+    auto bandwidths = std::vector<std::vector<Bandwidth>>(devices_count, std::vector<Bandwidth>(devices_count, 0));
+    auto latencies = std::vector<std::vector<Latency>>(devices_count, std::vector<Latency>(devices_count, 0));
+    const auto connect = [&](const int src, const int dest) {
+        bandwidths[src][dest] = bandwidths[dest][src] = config.bandwidth[0];
+        latencies[src][dest] = latencies[dest][src] = config.latency[0];
+    };
+    for (auto npu = 0; npu < npus_count; npu++) {
+        if (topology == "Ring") {
+            connect(npu, (npu + 1) % npus_count);
+        } else if (topology == "Switch") {
+            connect(npu, npus_count);
+        } else {
+            for (auto peer = npu + 1; peer < npus_count; peer++) {
+                connect(npu, peer);
+            }
+        }
+    }
+    topology_manager.reconfigure(std::move(bandwidths), std::move(latencies), config.reconfig_time);
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    // time the traffic from the end of the reconfiguration
+    const auto start_time = event_queue->get_current_time();
+    for (auto i = size_t{0}; i < srcs.size(); i++) {
+        topology_manager.send(std::make_unique<Reconfigurable::Chunk>(
+            sweep.size, topology_manager.route(srcs[i], dests[i]), ignore_chunk_arrival, nullptr, -1));
+    }
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    return event_queue->get_current_time() - start_time;
+}
+
+std::vector<EventTime> NetworkAnalytical::evaluate_sweep(const Sweep& sweep, const int threads_count) noexcept {
+    assert(threads_count > 0);
+
+    auto times = std::vector<EventTime>(sweep.get_configs_count());
+    run_work_stealing(times.size(), threads_count,
+                      [&](const size_t config_index) { times[config_index] = evaluate(sweep, config_index); });
+    return times;
+}
+
+void NetworkAnalytical::write_sweep_results(std::ostream& output,
+                                            const Sweep& sweep,
+                                            const std::vector<EventTime>& times) noexcept {
+    assert(times.size() == sweep.get_configs_count());
+
+    // write the results, column by column
+    const auto configs_count = sweep.get_configs_count();
+    output << "{\"backend\": \"" << sweep.backend << "\", \"seed\": " << sweep.seed
+           << ", \"configs_count\": " << configs_count << ", \"columns\": {";
+    output << "\n\"topology\": ";
+    write_column<std::string>(output, sweep, [](const NetworkConfig& config) { return config.topology; }, true);
+    output << ",\n\"npus_count\": ";
+    write_column<int>(output, sweep, [](const NetworkConfig& config) { return config.npus_count; }, false);
+    output << ",\n\"bandwidth\": ";
+    write_column<Bandwidth>(output, sweep, [](const NetworkConfig& config) { return config.bandwidth; }, false);
+    output << ",\n\"latency\": ";
+    write_column<Latency>(output, sweep, [](const NetworkConfig& config) { return config.latency; }, false);
+    output << ",\n\"time_ns\": [";
+    for (auto config_index = size_t{0}; config_index < configs_count; config_index++) {
+        output << (config_index == 0 ? "" : ", ") << times[config_index];
+    }
+    output << "]\n}}\n";
+}